@@ -0,0 +1,130 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Address.h"
+#include "AddressCache.h"
+#include "CompactAddress.h"
+#include "HexCoding.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Binance;
+using namespace Binance::Bench;
+
+BENCHMARK(Address_encode) {
+    const auto address = Address(Address::binanceHRP, parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5"));
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = address.encode();
+        keep(result);
+    }
+}
+
+// Into a fixed buffer, what the sign-bytes generator ran before the cache
+BENCHMARK(Address_encode_fixed) {
+    const auto keyHash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+    char out[Bech32::maxLength];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = Address::encode(out, Address::binanceHRP, 3, keyHash.data(), keyHash.size());
+        keep(result);
+        keep(out);
+    }
+}
+
+BENCHMARK(AddressCache_encode) {
+    static AddressCache cache;
+    const auto keyHash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+    char out[Bech32::maxLength];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = cache.encode(out, Network::mainnet, keyHash.data(), keyHash.size());
+        keep(result);
+        keep(out);
+    }
+}
+
+BENCHMARK(Address_decode) {
+    const std::string string = "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu";
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = Address::decode(string);
+        keep(result);
+    }
+}
+
+// Account books of 1000 entries, looked up by address string and by compact address
+static std::vector<CompactAddress> accounts() {
+    std::mt19937 random(7);
+    std::vector<CompactAddress> result(1000);
+    for (auto& address : result) {
+        for (auto& byte : address.keyHash) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+    return result;
+}
+
+BENCHMARK(AccountBook_string) {
+    static const auto keys = accounts();
+    static const auto book = [] {
+        std::unordered_map<std::string, int64_t> result;
+        for (const auto& key : keys) {
+            result[key.encode()] = 1;
+        }
+        return result;
+    }();
+    static const auto strings = [] {
+        std::vector<std::string> result;
+        for (const auto& key : keys) {
+            result.push_back(key.encode());
+        }
+        return result;
+    }();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = book.find(strings[i % strings.size()])->second;
+        keep(result);
+    }
+}
+
+BENCHMARK(AccountBook_compact) {
+    static const auto keys = accounts();
+    static const auto book = [] {
+        std::unordered_map<CompactAddress, int64_t> result;
+        for (const auto& key : keys) {
+            result[key] = 1;
+        }
+        return result;
+    }();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = book.find(keys[i % keys.size()])->second;
+        keep(result);
+    }
+}
+
+// Cycling through 1000 accounts, some of which collide in the default 4096 slots
+BENCHMARK(AddressCache_encode_accounts) {
+    static const auto keys = accounts();
+    static AddressCache cache;
+    char out[Bech32::maxLength];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        const auto& key = keys[i % keys.size()];
+        auto result = cache.encode(out, key.network, key.keyHash.data(), key.keyHash.size());
+        keep(result);
+        keep(out);
+    }
+}
+
+// Decoding into the compact type, without the heap strings of Address
+BENCHMARK(CompactAddress_decode) {
+    const std::string string = "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu";
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = CompactAddress::decode(string);
+        keep(result);
+    }
+}
@@ -0,0 +1,36 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Binance {
+namespace Bench {
+
+/// Runs the measured operation `iterations` times.
+using Function = std::function<void(std::size_t iterations)>;
+
+/// Adds a benchmark to the set run by the `benchmarks` executable.
+struct Registration {
+    Registration(const char* name, Function function);
+};
+
+/// Keeps a computed value alive so the optimizer cannot drop the work that produced it.
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+}} // namespace
+
+/// Defines and registers a benchmark body taking `std::size_t iterations`.
+#define BENCHMARK(name)                                                                         \
+    static void name##Benchmark(std::size_t iterations);                                        \
+    static const Binance::Bench::Registration name##Registration(#name, name##Benchmark);       \
+    static void name##Benchmark(std::size_t iterations)
@@ -0,0 +1,236 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/secp256k1.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace Binance::Bench;
+
+static const uint8_t privateKey[32] = {
+    0x90, 0x33, 0x5b, 0x9d, 0x21, 0x53, 0xad, 0x1a, 0x97, 0x99, 0xa3, 0xcc, 0xc0, 0x70, 0xbd, 0x64,
+    0xb4, 0x16, 0x4e, 0x96, 0x42, 0xee, 0x1d, 0xd4, 0x80, 0x53, 0xc3, 0x3f, 0x9a, 0x3a, 0x05, 0xe9,
+};
+
+static const uint8_t digest[32] = {
+    0x5f, 0x2b, 0x8c, 0x11, 0x07, 0x4a, 0x9d, 0x3e, 0x21, 0x66, 0xc0, 0x18, 0x93, 0x7e, 0x4b, 0xd2,
+    0x0a, 0x55, 0xe1, 0x3c, 0x76, 0x8f, 0x92, 0x40, 0xb7, 0x1d, 0x6a, 0x2e, 0xc9, 0x03, 0xf4, 0x88,
+};
+
+BENCHMARK(ecdsa_get_public_key33) {
+    uint8_t publicKey[33];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        ecdsa_get_public_key33(&secp256k1, privateKey, publicKey);
+        keep(publicKey);
+    }
+}
+
+// Decompressing a public key, mostly the square root
+BENCHMARK(ecdsa_read_pubkey) {
+    uint8_t publicKey[33];
+    ecdsa_get_public_key33(&secp256k1, privateKey, publicKey);
+    curve_point point;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = ecdsa_read_pubkey(&secp256k1, publicKey, &point);
+        keep(result);
+        keep(point);
+    }
+}
+
+BENCHMARK(point_multiply) {
+    bignum256 k;
+    bn_read_be(digest, &k);
+    curve_point result;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        point_multiply(&secp256k1, &k, &secp256k1.G, &result);
+        keep(result);
+    }
+}
+
+BENCHMARK(ecdsa_sign_digest) {
+    uint8_t signature[64];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        ecdsa_sign_digest(&secp256k1, privateKey, digest, signature, nullptr, nullptr);
+        keep(signature);
+    }
+}
+
+BENCHMARK(ecdsa_verify_digest) {
+    uint8_t publicKey[33], signature[64];
+    ecdsa_get_public_key33(&secp256k1, privateKey, publicKey);
+    ecdsa_sign_digest(&secp256k1, privateKey, digest, signature, nullptr, nullptr);
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = ecdsa_verify_digest(&secp256k1, publicKey, signature, digest);
+        keep(result);
+    }
+}
+
+// Without the square root that decompressing the public key costs
+BENCHMARK(ecdsa_verify_digest_uncompressed) {
+    uint8_t publicKey[65], signature[64];
+    ecdsa_get_public_key65(&secp256k1, privateKey, publicKey);
+    ecdsa_sign_digest(&secp256k1, privateKey, digest, signature, nullptr, nullptr);
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = ecdsa_verify_digest(&secp256k1, publicKey, signature, digest);
+        keep(result);
+    }
+}
+
+static const ecdsa_comb& comb8() {
+    static std::vector<fe_curve_point> table(ECDSA_COMB_SIZE(8));
+    static const ecdsa_comb comb = (ecdsa_comb_init(&secp256k1, 8, table.data()), ecdsa_comb{8, table.data()});
+    return comb;
+}
+
+// With the 8-bit table that SECP256K1_COMB_WINDOW=8 compiles in
+BENCHMARK(scalar_multiply_comb8) {
+    const auto& comb = comb8();
+    bignum256 k;
+    bn_read_be(digest, &k);
+    curve_point result;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        scalar_multiply_comb(&secp256k1, &comb, &k, &result);
+        keep(result);
+    }
+}
+
+BENCHMARK(scalar_multiply) {
+    bignum256 k;
+    bn_read_be(digest, &k);
+    curve_point result;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        scalar_multiply(&secp256k1, &k, &result);
+        keep(result);
+    }
+}
+
+static void scalarMultiplyBatch(std::size_t lanes, std::size_t iterations) {
+    const std::size_t count = 32;
+    if (!ecdsa_set_batch_lanes(lanes)) {
+        return;
+    }
+    std::vector<bignum256> scalars(count);
+    for (std::size_t i = 0; i < count; i += 1) {
+        uint8_t bytes[32];
+        std::memcpy(bytes, digest, 32);
+        bytes[0] = static_cast<uint8_t>(i);
+        bn_read_be(bytes, &scalars[i]);
+    }
+    std::vector<curve_point> results(count);
+    for (std::size_t i = 0; i < iterations; i += count) {
+        scalar_multiply_batch(&secp256k1, scalars.data(), results.data(), count);
+        keep(results);
+    }
+    ecdsa_set_batch_lanes(0);
+}
+
+// Per point, in batches of 32 one at a time
+BENCHMARK(scalar_multiply_batch_x1) {
+    scalarMultiplyBatch(1, iterations);
+}
+
+// Per point, in batches of 32 four at a time on AVX2
+BENCHMARK(scalar_multiply_batch_x4) {
+    scalarMultiplyBatch(4, iterations);
+}
+
+BENCHMARK(rfc6979_nonce) {
+    uint8_t nonce[32];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        rfc6979_state state;
+        init_rfc6979(privateKey, digest, &state);
+        generate_rfc6979(nonce, &state);
+        keep(nonce);
+    }
+}
+
+// With the per-key part of the derivation prepared once
+BENCHMARK(rfc6979_nonce_key) {
+    rfc6979_key key;
+    init_rfc6979_key(privateKey, &key);
+    uint8_t nonce[32];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        rfc6979_state state;
+        init_rfc6979_with_key(&key, digest, &state);
+        generate_rfc6979(nonce, &state);
+        keep(nonce);
+    }
+}
+
+// Per signature, in batches of 64
+BENCHMARK(ecdsa_sign_digest_batch) {
+    const std::size_t count = 64;
+    std::vector<uint8_t> privateKeys(32 * count), digests(32 * count), signatures(64 * count);
+    for (std::size_t i = 0; i < count; i += 1) {
+        std::memcpy(&privateKeys[32 * i], privateKey, 32);
+        std::memcpy(&digests[32 * i], digest, 32);
+        digests[32 * i] = static_cast<uint8_t>(i);
+    }
+    for (std::size_t i = 0; i < iterations; i += count) {
+        ecdsa_sign_digest_batch(&secp256k1, privateKeys.data(), digests.data(), count, signatures.data(), nullptr);
+        keep(signatures);
+    }
+}
+
+// Per signature, in batches of 64
+BENCHMARK(ecdsa_verify_digest_batch) {
+    const std::size_t count = 64;
+    static std::vector<uint8_t> publicKeys(33 * count), digests(32 * count), signatures(64 * count);
+    static const bool prepared = [] {
+        for (std::size_t i = 0; i < count; i += 1) {
+            ecdsa_get_public_key33(&secp256k1, privateKey, &publicKeys[33 * i]);
+            std::memcpy(&digests[32 * i], digest, 32);
+            digests[32 * i] = static_cast<uint8_t>(i);
+            ecdsa_sign_digest(&secp256k1, privateKey, &digests[32 * i], &signatures[64 * i], nullptr, nullptr);
+        }
+        return true;
+    }();
+    keep(prepared);
+    std::vector<int> results(count);
+    for (std::size_t i = 0; i < iterations; i += count) {
+        ecdsa_verify_digest_batch(&secp256k1, publicKeys.data(), signatures.data(), digests.data(), count, results.data());
+        keep(results);
+    }
+}
+
+BENCHMARK(ecdsa_recover_pub_from_sig) {
+    uint8_t signature[64], publicKey[65], recoveryId;
+    ecdsa_sign_digest(&secp256k1, privateKey, digest, signature, &recoveryId, nullptr);
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = ecdsa_recover_pub_from_sig(&secp256k1, publicKey, signature, digest, recoveryId);
+        keep(result);
+        keep(publicKey);
+    }
+}
+
+// Per signature, in batches of 64
+BENCHMARK(ecdsa_recover_pub_from_sig_batch) {
+    const std::size_t count = 64;
+    static std::vector<uint8_t> digests(32 * count), signatures(64 * count);
+    static std::vector<int> recoveryIds(count);
+    static const bool prepared = [] {
+        for (std::size_t i = 0; i < count; i += 1) {
+            std::memcpy(&digests[32 * i], digest, 32);
+            digests[32 * i] = static_cast<uint8_t>(i);
+            uint8_t by;
+            ecdsa_sign_digest(&secp256k1, privateKey, &digests[32 * i], &signatures[64 * i], &by, nullptr);
+            recoveryIds[i] = by;
+        }
+        return true;
+    }();
+    keep(prepared);
+    std::vector<uint8_t> publicKeys(33 * count);
+    std::vector<int> results(count);
+    for (std::size_t i = 0; i < iterations; i += count) {
+        ecdsa_recover_pub_from_sig_batch(&secp256k1, signatures.data(), digests.data(), recoveryIds.data(), count, publicKeys.data(), results.data());
+        keep(publicKeys);
+    }
+}
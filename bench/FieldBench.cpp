@@ -0,0 +1,130 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include "crypto/bignum.h"
+#include "crypto/secp256k1.h"
+#include "crypto/secp256k1_field.h"
+#include "crypto/secp256k1_field_x4.h"
+
+using namespace Binance::Bench;
+
+static bignum256 element() {
+    static const uint8_t bytes[32] = {
+        0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b, 0x07,
+        0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17, 0x98,
+    };
+    bignum256 x;
+    bn_read_be(bytes, &x);
+    return x;
+}
+
+BENCHMARK(bn_multiply) {
+    auto x = element(), y = element();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        bn_multiply(&y, &x, &secp256k1.prime);
+    }
+    keep(x);
+}
+
+BENCHMARK(bn_inverse) {
+    auto x = element();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        bn_inverse(&x, &secp256k1.prime);
+    }
+    keep(x);
+}
+
+BENCHMARK(bn_sqrt) {
+    auto x = element();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        bn_sqrt(&x, &secp256k1.prime);
+    }
+    keep(x);
+}
+
+static secp256k1_fe fieldElement() {
+    secp256k1_fe r;
+    auto x = element();
+    secp256k1_fe_set_bn(&r, &x);
+    return r;
+}
+
+BENCHMARK(secp256k1_fe_mul) {
+    auto x = fieldElement(), y = fieldElement();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_fe_mul(&x, &x, &y);
+    }
+    keep(x);
+}
+
+BENCHMARK(secp256k1_fe_sqr) {
+    auto x = fieldElement();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_fe_sqr(&x, &x);
+    }
+    keep(x);
+}
+
+BENCHMARK(secp256k1_fe_inv) {
+    auto x = fieldElement();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_fe_inv(&x, &x);
+    }
+    keep(x);
+}
+
+// Fermat inversion with an addition chain, for comparison
+BENCHMARK(secp256k1_fe_inv_pow) {
+    auto x = fieldElement();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_fe_inv_pow(&x, &x);
+    }
+    keep(x);
+}
+
+BENCHMARK(secp256k1_fe_sqrt) {
+    auto x = fieldElement();
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_fe_sqrt(&x, &x);
+    }
+    keep(x);
+}
+
+static secp256k1_fe_x4 fieldElementX4() {
+    secp256k1_fe_x4 r;
+    auto x = fieldElement();
+    for (auto lane = 0; lane < 4; lane += 1) {
+        secp256k1_fe_x4_set_lane(&r, lane, &x);
+    }
+    return r;
+}
+
+// Per element, four per call
+BENCHMARK(secp256k1_fe_x4_mul) {
+    if (!secp256k1_fe_x4_supported()) {
+        return;
+    }
+    auto x = fieldElementX4(), y = fieldElementX4();
+    for (std::size_t i = 0; i < iterations; i += 4) {
+        secp256k1_fe_x4_mul(&x, &x, &y);
+    }
+    keep(x);
+}
+
+// Per element, four per call
+BENCHMARK(secp256k1_fe_x4_sqr) {
+    if (!secp256k1_fe_x4_supported()) {
+        return;
+    }
+    auto x = fieldElementX4();
+    for (std::size_t i = 0; i < iterations; i += 4) {
+        secp256k1_fe_x4_sqr(&x, &x);
+    }
+    keep(x);
+}
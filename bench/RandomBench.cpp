@@ -0,0 +1,27 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include "crypto/rand.h"
+
+using namespace Binance::Bench;
+
+BENCHMARK(random32) {
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto value = random32();
+        keep(value);
+    }
+}
+
+BENCHMARK(random_buffer32) {
+    uint8_t buffer[32];
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        random_buffer(buffer, sizeof(buffer));
+        keep(buffer);
+    }
+}
@@ -0,0 +1,57 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include "crypto/bignum.h"
+#include "crypto/secp256k1.h"
+#include "crypto/secp256k1_scalar.h"
+
+using namespace Binance::Bench;
+
+static const uint8_t scalarBytes[32] = {
+    0x4c, 0x0e, 0xa6, 0x5b, 0x1a, 0x3d, 0x91, 0x0f, 0x77, 0x2e, 0x0b, 0x5d, 0x4b, 0x17, 0x94, 0x2a,
+    0x6c, 0x80, 0x15, 0xe3, 0xc9, 0x01, 0x5b, 0x3e, 0x02, 0x74, 0xc8, 0x51, 0x9f, 0x33, 0x6d, 0x0c,
+};
+
+BENCHMARK(bn_multiply_order) {
+    bignum256 x, y;
+    bn_read_be(scalarBytes, &x);
+    y = x;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        bn_multiply(&y, &x, &secp256k1.order);
+    }
+    keep(x);
+}
+
+BENCHMARK(bn_inverse_order) {
+    bignum256 x;
+    bn_read_be(scalarBytes, &x);
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        bn_inverse(&x, &secp256k1.order);
+    }
+    keep(x);
+}
+
+BENCHMARK(secp256k1_scalar_mul) {
+    secp256k1_scalar x, y;
+    secp256k1_scalar_set_b32(&x, scalarBytes);
+    y = x;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_scalar_mul(&x, &x, &y);
+    }
+    keep(x);
+}
+
+BENCHMARK(secp256k1_scalar_inverse) {
+    secp256k1_scalar x;
+    secp256k1_scalar_set_b32(&x, scalarBytes);
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        secp256k1_scalar_inverse(&x, &x);
+    }
+    keep(x);
+}
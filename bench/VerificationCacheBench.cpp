@@ -0,0 +1,32 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include "VerificationCache.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/secp256k1.h"
+
+using namespace Binance;
+using namespace Binance::Bench;
+
+// Repeated verifications against one key, which stays cached after the first one
+BENCHMARK(VerificationCache_verify) {
+    const auto privateKey = Data(32, 0x42);
+    auto publicKey = Data(33);
+    auto signature = Data(64);
+    const auto digest = Data(32, 0x17);
+    ecdsa_get_public_key33(&secp256k1, privateKey.data(), publicKey.data());
+    ecdsa_sign_digest(&secp256k1, privateKey.data(), digest.data(), signature.data(), nullptr, nullptr);
+
+    VerificationCache cache;
+    for (std::size_t i = 0; i < iterations; i += 1) {
+        auto result = cache.verify(publicKey, signature, digest);
+        keep(result);
+    }
+}
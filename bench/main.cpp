@@ -0,0 +1,54 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Binance::Bench;
+
+static std::vector<std::pair<std::string, Function>>& registry() {
+    static std::vector<std::pair<std::string, Function>> benchmarks;
+    return benchmarks;
+}
+
+Registration::Registration(const char* name, Function function) {
+    registry().emplace_back(name, std::move(function));
+}
+
+// Times `function`, doubling the iteration count until a run takes long enough to be meaningful.
+static double nanosecondsPerIteration(const Function& function) {
+    using Clock = std::chrono::steady_clock;
+    const auto minimum = std::chrono::milliseconds(200);
+    for (std::size_t iterations = 1;; iterations *= 2) {
+        const auto start = Clock::now();
+        function(iterations);
+        const auto elapsed = Clock::now() - start;
+        if (elapsed >= minimum) {
+            return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        }
+    }
+}
+
+/// Runs every benchmark whose name contains one of the arguments, or all of them.
+int main(int argc, char** argv) {
+    for (const auto& benchmark : registry()) {
+        auto selected = argc < 2;
+        for (auto i = 1; i < argc; i += 1) {
+            selected = selected || benchmark.first.find(argv[i]) != std::string::npos;
+        }
+        if (selected) {
+            std::printf("%-36s %14.1f ns/op\n", benchmark.first.c_str(), nanosecondsPerIteration(benchmark.second));
+        }
+    }
+    return 0;
+}
@@ -12,8 +12,13 @@
 #include "Data.h"
 #include "crypto/ecdsa.h"
 
+#include <cstring>
+
 using namespace Binance;
 
+constexpr const char* Address::binanceHRP;
+constexpr const char* Address::binanceTestHRP;
+
 bool Address::isValid(const std::string& addr) {
     auto dec = Bech32::decode(addr);
     if (dec.second.empty()) {
@@ -30,36 +35,42 @@ bool Address::isValid(const std::string& addr) {
     return true;
 }
 
-std::pair<Address, bool> Address::decode(const std::string& addr) {
-    auto dec = Bech32::decode(addr);
-    if (dec.second.empty()) {
-        return std::make_pair(Address(), false);
+bool Address::networkOf(const char* hrp, std::size_t length, Network& network) {
+    if (length == 3 && std::memcmp(hrp, binanceHRP, 3) == 0) {
+        network = Network::mainnet;
+        return true;
     }
-
-    bool test;
-    if (dec.first == "bnb") {
-        test = false;
-    } else if (dec.first == "tbnb") {
-        test = true;
-    } else {
-        return std::make_pair(Address(), false);
+    if (length == 4 && std::memcmp(hrp, binanceTestHRP, 4) == 0) {
+        network = Network::testnet;
+        return true;
     }
+    return false;
+}
 
-    Data conv;
-    auto success = Bech32::convertBits<5, 8, false>(conv, Data(dec.second.begin(), dec.second.end()));
-    if (!success || conv.size() < 2 || conv.size() > 40) {
+std::pair<Address, bool> Address::decode(const std::string& addr) {
+    char hrp[Bech32::maxLength];
+    uint8_t keyHash[Bech32::maxLength];
+    std::size_t hrpLength, size;
+    Network network;
+    if (!Bech32::decode(addr.data(), addr.size(), hrp, hrpLength, keyHash, size) ||
+        !networkOf(hrp, hrpLength, network) || size < 2 || size > 40) {
         return std::make_pair(Address(), false);
     }
 
-    return std::make_pair(Address(dec.first, std::move(conv)), true);
+    return std::make_pair(Address(std::string(hrp, hrpLength), Data(keyHash, keyHash + size)), true);
 }
 
 std::string Address::encode() const {
-    Data enc;
-    Bech32::convertBits<8, 5, true>(enc, keyHash);
-    std::string result = Bech32::encode(hrp, enc);
-    if (!decode(result).second) {
-        return {};
+    char out[Bech32::maxLength];
+    const auto length = encode(out, hrp.data(), hrp.size(), keyHash.data(), keyHash.size());
+    return std::string(out, length);
+}
+
+std::size_t Address::encode(char out[Bech32::maxLength], const char* hrp, std::size_t hrpLength, const uint8_t* keyHash, std::size_t size) {
+    // the limits Address::decode accepts, so every encoded address decodes
+    Network network;
+    if (!networkOf(hrp, hrpLength, network) || size < 2 || size > 40) {
+        return 0;
     }
-    return result;
+    return Bech32::encode(out, hrp, hrpLength, keyHash, size);
 }
@@ -7,13 +7,24 @@
 
 #pragma once
 
+#include "Bech32.h"
 #include "Data.h"
 
 #include <stdint.h>
+#include <cstddef>
 #include <string>
 
 namespace Binance {
 
+/// Binance Chain network, which determines the human-readable part of an address.
+enum class Network : uint8_t {
+    /// `Address::binanceHRP`.
+    mainnet,
+
+    /// `Address::binanceTestHRP`.
+    testnet,
+};
+
 class Address {
 public:
     static constexpr auto binanceHRP = "bnb";
@@ -28,6 +39,11 @@ public:
     /// Public key hash.
     Data keyHash;
 
+    /// Determines the network of a human-readable part.
+    ///
+    /// \returns false if `hrp` is not `binanceHRP` or `binanceTestHRP`, leaving `network` unchanged.
+    static bool networkOf(const char* hrp, std::size_t length, Network& network);
+
     /// Determines whether a string makes a valid Tendermint address.
     static bool isValid(const std::string& string);
 
@@ -47,6 +63,12 @@ public:
     /// \returns encoded address string, or empty string on failure.
     std::string encode() const;
 
+    /// Encodes a key hash as an address into a fixed buffer, without allocating.
+    ///
+    /// \returns the length of the address written to `out`, or 0 if `hrp` is not `binanceHRP` or `binanceTestHRP`
+    ///     or the key hash is not 2 to 40 bytes long.
+    static std::size_t encode(char out[Bech32::maxLength], const char* hrp, std::size_t hrpLength, const uint8_t* keyHash, std::size_t size);
+
     bool operator==(const Address& rhs) const {
         return hrp == rhs.hrp && keyHash == rhs.keyHash;
     }
@@ -0,0 +1,137 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "AddressCache.h"
+#include "HashMix.h"
+
+#include <cstring>
+#include <new>
+
+using namespace Binance;
+
+constexpr std::size_t AddressCache::cacheLineSize;
+constexpr std::size_t AddressCache::keySize;
+constexpr std::size_t AddressCache::dataLength;
+constexpr std::size_t AddressCache::slotBytes;
+constexpr std::size_t AddressCache::counterShards;
+
+static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+AddressCache::AddressCache(std::size_t capacity)
+    : slotCount(capacity == 0 ? 0 : roundUpToPowerOfTwo(capacity))
+    , storage(new unsigned char[(counterShards + slotCount + 1) * cacheLineSize]) {
+    void* aligned = storage.get();
+    auto space = (counterShards + slotCount + 1) * cacheLineSize;
+    std::align(cacheLineSize, (counterShards + slotCount) * cacheLineSize, aligned, space);
+    counters = new (aligned) Counters[counterShards];
+    slots = new (static_cast<unsigned char*>(aligned) + counterShards * sizeof(Counters)) Slot[slotCount];
+}
+
+AddressCache& AddressCache::shared() {
+    static AddressCache cache;
+    return cache;
+}
+
+std::uint64_t AddressCache::hits() const {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < counterShards; i += 1) {
+        total += counters[i].hits.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::uint64_t AddressCache::misses() const {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < counterShards; i += 1) {
+        total += counters[i].misses.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+AddressCache::Counters& AddressCache::threadCounters() {
+    static std::atomic<std::size_t> threads{0};
+    thread_local const auto shard = threads.fetch_add(1, std::memory_order_relaxed) % counterShards;
+    return counters[shard];
+}
+
+std::size_t AddressCache::encode(char out[Bech32::maxLength], Network network, const uint8_t* keyHash, std::size_t size) {
+    const auto hrp = network == Network::testnet ? Address::binanceTestHRP : Address::binanceHRP;
+    const auto hrpLength = std::strlen(hrp);
+    if (size != CompactAddress::size || slotCount == 0) {
+        return Address::encode(out, hrp, hrpLength, keyHash, size);
+    }
+
+    uint8_t key[keySize];
+    std::memcpy(key, keyHash, CompactAddress::size);
+    key[CompactAddress::size] = static_cast<uint8_t>(network);
+    const auto index = hashBytes<CompactAddress::size>(keyHash, static_cast<uint64_t>(network)) & (slotCount - 1);
+    auto& slot = slots[index];
+
+    const auto length = hrpLength + 1 + dataLength;
+    auto& counts = threadCounters();
+    if (find(slot, key, out + hrpLength + 1)) {
+        std::memcpy(out, hrp, hrpLength);
+        out[hrpLength] = '1';
+        counts.hits.fetch_add(1, std::memory_order_relaxed);
+        return length;
+    }
+    counts.misses.fetch_add(1, std::memory_order_relaxed);
+    const auto encoded = Address::encode(out, hrp, hrpLength, keyHash, size);
+    if (encoded == length) {
+        insert(slot, key, out + hrpLength + 1);
+    }
+    return encoded;
+}
+
+bool AddressCache::find(const Slot& slot, const uint8_t key[keySize], char out[dataLength]) {
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1) != 0) {
+        return false;
+    }
+    uint8_t bytes[slotBytes];
+    const auto head = slot.head.load(std::memory_order_relaxed);
+    std::memcpy(bytes, &head, sizeof(head));
+    for (std::size_t i = 0; i < 7; i += 1) {
+        const auto word = slot.words[i].load(std::memory_order_relaxed);
+        std::memcpy(bytes + sizeof(head) + sizeof(word) * i, &word, sizeof(word));
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence || std::memcmp(bytes, key, keySize) != 0) {
+        return false;
+    }
+    std::memcpy(out, bytes + keySize, dataLength);
+    return true;
+}
+
+void AddressCache::insert(Slot& slot, const uint8_t key[keySize], const char data[dataLength]) {
+    uint8_t bytes[slotBytes] = {};
+    std::memcpy(bytes, key, keySize);
+    std::memcpy(bytes + keySize, data, dataLength);
+
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) != 0 || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    uint32_t head;
+    std::memcpy(&head, bytes, sizeof(head));
+    slot.head.store(head, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < 7; i += 1) {
+        uint64_t word;
+        std::memcpy(&word, bytes + sizeof(head) + sizeof(word) * i, sizeof(word));
+        slot.words[i].store(word, std::memory_order_relaxed);
+    }
+    // skip 0 when the sequence wraps around, which marks empty slots
+    const auto next = sequence + 2 == 0 ? 2 : sequence + 2;
+    slot.sequence.store(next, std::memory_order_release);
+}
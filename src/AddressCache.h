@@ -0,0 +1,105 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Bech32.h"
+#include "CompactAddress.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace Binance {
+
+/// Encodes Binance Chain addresses and keeps the strings of recently encoded 20-byte key hashes.
+///
+/// The cache is a fixed table of `capacity` slots indexed by the key hash and its network, so each HRP has its own
+/// entries and a new key hash replaces whichever one shared its slot. Every slot is guarded by a sequence number:
+/// lookups copy the slot without taking a lock and treat a slot that changed during the copy as a miss, and a writer
+/// skips a slot another writer is updating, so no call ever waits. Slots and the per-thread shards of the hit and miss
+/// counts each fill one cache line, so threads only share the lines of the addresses they encode. All members may be
+/// called from several threads at once.
+class AddressCache {
+public:
+    /// Initializes an empty cache with `capacity` slots, rounded up to a power of two; `0` disables caching.
+    explicit AddressCache(std::size_t capacity = 4096);
+
+    AddressCache(const AddressCache&) = delete;
+    AddressCache& operator=(const AddressCache&) = delete;
+
+    /// Encodes the address of `keyHash` on `network` into a fixed buffer.
+    ///
+    /// Key hashes of other sizes than `CompactAddress::size` are encoded without the cache and do not count as
+    /// hits or misses.
+    ///
+    /// \returns the length of the address written to `out`, or 0 under the conditions of `Address::encode`.
+    std::size_t encode(char out[Bech32::maxLength], Network network, const uint8_t* keyHash, std::size_t size);
+
+    /// Number of encodings that found their address in the cache.
+    std::uint64_t hits() const;
+
+    /// Number of encodings that had to run the Bech32 encoder.
+    std::uint64_t misses() const;
+
+    /// Number of slots.
+    std::size_t capacity() const { return slotCount; }
+
+    /// Cache shared by the sign-bytes generator in `Serialization.cpp`.
+    static AddressCache& shared();
+
+private:
+    static constexpr std::size_t cacheLineSize = 64;
+
+    /// Bytes of a key: the key hash and the network.
+    static constexpr std::size_t keySize = CompactAddress::size + 1;
+
+    /// Characters of an address after the separator, 32 of data and 6 of checksum; the human-readable part before
+    /// them follows from the network.
+    static constexpr std::size_t dataLength = 38;
+
+    /// Cached address, stored as atomic words so that concurrent copies of a slot being rewritten are well defined.
+    ///
+    /// `head` and `words` hold the key followed by the data characters.
+    struct alignas(cacheLineSize) Slot {
+        /// Odd while a writer is updating the slot; 0 while the slot is empty.
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint32_t> head;
+        std::atomic<uint64_t> words[7];
+    };
+    static constexpr std::size_t slotBytes = sizeof(uint32_t) + 7 * sizeof(uint64_t);
+    static_assert(keySize + dataLength <= slotBytes, "a slot must hold a key and its address");
+    static_assert(sizeof(Slot) == cacheLineSize, "a slot must fill one cache line");
+
+    /// Hit and miss counts of the threads that map to one shard.
+    struct alignas(cacheLineSize) Counters {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+    };
+    static constexpr std::size_t counterShards = 16;
+
+    /// Looks up the address of a packed key in its slot.
+    ///
+    /// \returns whether the slot held the key, in which case its data characters are copied to `out`.
+    static bool find(const Slot& slot, const uint8_t key[keySize], char out[dataLength]);
+
+    /// Stores the data characters of a key's address in its slot unless another thread is updating that slot.
+    static void insert(Slot& slot, const uint8_t key[keySize], const char data[dataLength]);
+
+    /// Counters of the calling thread.
+    Counters& threadCounters();
+
+    const std::size_t slotCount;
+
+    /// Storage of the counter shards followed by the slots, since `new` does not align to cache lines before C++17.
+    std::unique_ptr<unsigned char[]> storage;
+    Counters* counters;
+    Slot* slots;
+};
+
+} // namespace
@@ -0,0 +1,145 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "AddressDerivation.h"
+
+#include "Bech32.h"
+#include "Parallel.h"
+#include "SigningKey.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/hasher.h"
+#include "crypto/memzero.h"
+#include "crypto/secp256k1.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Binance;
+
+// Keys a worker derives at a time, a few batched scalar multiplications' worth.
+static const std::size_t derivationChunkSize = 4 * SCALAR_MULTIPLY_BATCH;
+
+// Signatures a worker recovers at a time.
+static const std::size_t recoveryChunkSize = 64;
+static_assert(recoveryChunkSize <= derivationChunkSize, "encodeAddresses takes up to derivationChunkSize keys");
+
+// Fills `results[i]` with the compressed public key `publicKeys + 33 * i` and its address, for at
+// most `derivationChunkSize` keys.
+static void encodeAddresses(const uint8_t* publicKeys, std::size_t count, const std::string& hrp, DerivedAddress* const results[]) {
+    uint8_t keyHashes[derivationChunkSize][HASHER_DIGEST_LENGTH];
+    const uint8_t* hashInputs[derivationChunkSize] = {};
+    std::size_t hashLengths[derivationChunkSize] = {};
+    uint8_t* hashOutputs[derivationChunkSize] = {};
+
+    for (std::size_t i = 0; i < count; i += 1) {
+        hashInputs[i] = publicKeys + 33 * i;
+        hashLengths[i] = 33;
+        hashOutputs[i] = keyHashes[i];
+    }
+    hasher_Raw_xN(HASHER_SHA2_RIPEMD, hashInputs, hashLengths, count, hashOutputs);
+
+    char address[Bech32::maxLength];
+    for (std::size_t i = 0; i < count; i += 1) {
+        auto& derived = *results[i];
+        derived.publicKey.assign(publicKeys + 33 * i, publicKeys + 33 * (i + 1));
+        const auto length = Bech32::encode(address, hrp.data(), hrp.size(), keyHashes[i], 20);
+        derived.address.assign(address, length);
+    }
+}
+
+// Derives the keys in `[begin, end)`, at most `derivationChunkSize` of them.
+static void deriveChunk(const std::vector<Data>& privateKeys, std::size_t begin, std::size_t end, const std::string& hrp, std::vector<DerivedAddress>& result) {
+    const auto count = end - begin;
+    uint8_t privateKeyBuffer[32 * derivationChunkSize];
+    uint8_t publicKeys[33 * derivationChunkSize];
+    DerivedAddress* results[derivationChunkSize];
+
+    for (std::size_t i = 0; i < count; i += 1) {
+        std::copy(privateKeys[begin + i].begin(), privateKeys[begin + i].end(), privateKeyBuffer + 32 * i);
+        results[i] = &result[begin + i];
+    }
+    ecdsa_get_public_key33_batch(&secp256k1, privateKeyBuffer, count, publicKeys);
+    memzero(privateKeyBuffer, sizeof(privateKeyBuffer));
+    encodeAddresses(publicKeys, count, hrp, results);
+}
+
+// Recovers the keys of the signatures in `[begin, end)`, at most `recoveryChunkSize` of them.
+static void recoverChunk(const std::vector<RecoverableSignature>& signatures, std::size_t begin, std::size_t end, const std::string& hrp, std::vector<DerivedAddress>& result) {
+    const auto count = end - begin;
+    uint8_t sigs[64 * recoveryChunkSize] = {};
+    uint8_t digests[32 * recoveryChunkSize] = {};
+    int recoveryIds[recoveryChunkSize] = {};
+    uint8_t publicKeys[33 * recoveryChunkSize];
+    int status[recoveryChunkSize];
+
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto& signature = signatures[begin + i];
+        std::copy(signature.signature.begin(), signature.signature.end(), sigs + 64 * i);
+        std::copy(signature.digest.begin(), signature.digest.end(), digests + 32 * i);
+        recoveryIds[i] = signature.recoveryId;
+    }
+    ecdsa_recover_pub_from_sig_batch(&secp256k1, sigs, digests, recoveryIds, count, publicKeys, status);
+
+    // only the recovered keys go on to hashing
+    DerivedAddress* results[recoveryChunkSize];
+    std::size_t recovered = 0;
+    for (std::size_t i = 0; i < count; i += 1) {
+        if (status[i] != 0) {
+            continue;
+        }
+        std::copy(publicKeys + 33 * i, publicKeys + 33 * (i + 1), publicKeys + 33 * recovered);
+        results[recovered] = &result[begin + i];
+        recovered += 1;
+    }
+    encodeAddresses(publicKeys, recovered, hrp, results);
+}
+
+// Determines whether addresses can be encoded with a human-readable part.
+static bool isValidHRP(const std::string& hrp) {
+    const uint8_t keyHash[20] = {};
+    char address[Bech32::maxLength];
+    return Bech32::encode(address, hrp.data(), hrp.size(), keyHash, sizeof(keyHash)) != 0;
+}
+
+std::vector<DerivedAddress> Binance::deriveAddresses(const std::vector<Data>& privateKeys, const std::string& hrp, unsigned threads) {
+    if (!isValidHRP(hrp)) {
+        throw std::invalid_argument("Invalid human-readable part");
+    }
+    for (const auto& privateKey : privateKeys) {
+        if (!SigningKey::isValid(privateKey)) {
+            throw std::invalid_argument("Invalid private key");
+        }
+    }
+
+    std::vector<DerivedAddress> result(privateKeys.size());
+    parallelFor(privateKeys.size(), threads, derivationChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (auto chunk = begin; chunk < end; chunk += derivationChunkSize) {
+            deriveChunk(privateKeys, chunk, std::min(chunk + derivationChunkSize, end), hrp, result);
+        }
+    });
+    return result;
+}
+
+std::vector<DerivedAddress> Binance::recoverAddresses(const std::vector<RecoverableSignature>& signatures, const std::string& hrp, unsigned threads) {
+    if (!isValidHRP(hrp)) {
+        throw std::invalid_argument("Invalid human-readable part");
+    }
+    for (const auto& signature : signatures) {
+        if (signature.signature.size() != 64 || signature.digest.size() != 32 || signature.recoveryId < 0 || signature.recoveryId > 3) {
+            throw std::invalid_argument("Invalid recoverable signature");
+        }
+    }
+
+    std::vector<DerivedAddress> result(signatures.size());
+    parallelFor(signatures.size(), threads, recoveryChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (auto chunk = begin; chunk < end; chunk += recoveryChunkSize) {
+            recoverChunk(signatures, chunk, std::min(chunk + recoveryChunkSize, end), hrp, result);
+        }
+    });
+    return result;
+}
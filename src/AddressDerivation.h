@@ -0,0 +1,61 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "Data.h"
+
+#include <string>
+#include <vector>
+
+namespace Binance {
+
+/// Public key and address derived from a private key.
+struct DerivedAddress {
+    /// Compressed public key, 33 bytes.
+    Data publicKey;
+
+    /// Bech32 address of the public key hash.
+    std::string address;
+};
+
+/// Derives the compressed public keys and addresses of many private keys.
+///
+/// Keys are processed in groups that share one field inversion for the conversion to affine
+/// coordinates, and the key hashes are computed with the multi-lane SHA-256 and RIPEMD-160.
+/// Results are in the order of `privateKeys`.
+///
+/// \param threads number of worker threads, `0` for one per hardware thread.
+/// \throws std::invalid_argument if a private key is not a valid secp256k1 private key or `hrp` is not a valid
+///     Bech32 human-readable part.
+std::vector<DerivedAddress> deriveAddresses(const std::vector<Data>& privateKeys, const std::string& hrp = Address::binanceHRP, unsigned threads = 0);
+
+/// Signature together with what public key recovery needs besides it.
+struct RecoverableSignature {
+    /// Signature `r || s`, 64 bytes.
+    Data signature;
+
+    /// SHA-256 digest of the signed message, 32 bytes.
+    Data digest;
+
+    /// Recovery id from 0 to 3: the parity of R's y coordinate, plus 2 if R's x coordinate is r + n.
+    int recoveryId = 0;
+};
+
+/// Recovers the compressed public keys and addresses that produced many signatures.
+///
+/// Signatures are processed in groups that share the inversions of their R points and of their
+/// r values, and each key takes a single interleaved multiplication of R and G. Results are in the
+/// order of `signatures`; entries for signatures that no public key produces are empty.
+///
+/// \param threads number of worker threads, `0` for one per hardware thread.
+/// \throws std::invalid_argument if a signature, digest or recovery id is malformed, or `hrp` is not a valid
+///     Bech32 human-readable part.
+std::vector<DerivedAddress> recoverAddresses(const std::vector<RecoverableSignature>& signatures, const std::string& hrp = Address::binanceHRP, unsigned threads = 0);
+
+} // namespace
@@ -0,0 +1,287 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Amino.h"
+
+#include "Orders.h"
+#include "Signer.h"
+
+#include <cstring>
+
+using namespace Binance;
+
+// Message prefixes
+static const byte sendOrderPrefix[] = { 0x2A, 0x2C, 0x87, 0xFA };
+static const byte tradeOrderPrefix[] = { 0xCE, 0x6D, 0xC0, 0x43 };
+static const byte cancelTradeOrderPrefix[] = { 0x16, 0x6E, 0x68, 0x1B };
+static const byte tokenFreezeOrderPrefix[] = { 0xE7, 0x74, 0xB3, 0x2D };
+static const byte tokenUnfreezeOrderPrefix[] = { 0x65, 0x15, 0xFF, 0x0D };
+static const byte pubKeyPrefix[] = { 0xEB, 0x5A, 0xE9, 0x87 };
+static const byte transactionPrefix[] = { 0xF0, 0x62, 0x5D, 0xEE };
+
+static const std::size_t prefixSize = 4;
+
+// Wire types
+static const byte varintType = 0;
+static const byte bytesType = 2;
+
+namespace {
+
+/// Sizes and writes proto3 fields. Every field number in `dex.proto` is below 16, so tags take one byte.
+class Encoder {
+public:
+    explicit Encoder(byte* output) : cursor(output) {}
+
+    static std::size_t varintSize(uint64_t value) {
+        std::size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size += 1;
+        }
+        return size;
+    }
+
+    /// Size of a length-delimited field, emitted even when empty.
+    static std::size_t bytesFieldSize(std::size_t length) {
+        return 1 + varintSize(length) + length;
+    }
+
+    /// Size of a singular bytes or string field, omitted when empty.
+    static std::size_t optionalFieldSize(std::size_t length) {
+        return length == 0 ? 0 : bytesFieldSize(length);
+    }
+
+    /// Size of a singular int64 field, omitted when zero.
+    static std::size_t intFieldSize(int64_t value) {
+        return value == 0 ? 0 : 1 + varintSize(static_cast<uint64_t>(value));
+    }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            *cursor++ = static_cast<byte>(value | 0x80);
+            value >>= 7;
+        }
+        *cursor++ = static_cast<byte>(value);
+    }
+
+    void raw(const void* data, std::size_t size) {
+        std::memcpy(cursor, data, size);
+        cursor += size;
+    }
+
+    void header(int field, std::size_t length) {
+        *cursor++ = static_cast<byte>(field << 3 | bytesType);
+        varint(length);
+    }
+
+    void bytesField(int field, const void* data, std::size_t size) {
+        header(field, size);
+        raw(data, size);
+    }
+
+    void optionalField(int field, const std::string& value) {
+        if (!value.empty()) {
+            bytesField(field, value.data(), value.size());
+        }
+    }
+
+    void intField(int field, int64_t value) {
+        if (value != 0) {
+            *cursor++ = static_cast<byte>(field << 3 | varintType);
+            varint(static_cast<uint64_t>(value));
+        }
+    }
+
+    byte* cursor;
+};
+
+const byte* typePrefix(const NewOrder&) { return tradeOrderPrefix; }
+const byte* typePrefix(const CancelOrder&) { return cancelTradeOrderPrefix; }
+const byte* typePrefix(const Send&) { return sendOrderPrefix; }
+const byte* typePrefix(const TokenFreeze&) { return tokenFreezeOrderPrefix; }
+const byte* typePrefix(const TokenUnfreeze&) { return tokenUnfreezeOrderPrefix; }
+
+std::size_t bodySize(const NewOrder& order) {
+    return Encoder::optionalFieldSize(order.sender().size())
+        + Encoder::optionalFieldSize(order.id().size())
+        + Encoder::optionalFieldSize(order.symbol().size())
+        + Encoder::intFieldSize(order.ordertype())
+        + Encoder::intFieldSize(order.side())
+        + Encoder::intFieldSize(order.price())
+        + Encoder::intFieldSize(order.quantity())
+        + Encoder::intFieldSize(order.timeinforce());
+}
+
+void writeBody(Encoder& encoder, const NewOrder& order) {
+    encoder.optionalField(1, order.sender());
+    encoder.optionalField(2, order.id());
+    encoder.optionalField(3, order.symbol());
+    encoder.intField(4, order.ordertype());
+    encoder.intField(5, order.side());
+    encoder.intField(6, order.price());
+    encoder.intField(7, order.quantity());
+    encoder.intField(8, order.timeinforce());
+}
+
+std::size_t bodySize(const CancelOrder& order) {
+    return Encoder::optionalFieldSize(order.sender().size())
+        + Encoder::optionalFieldSize(order.symbol().size())
+        + Encoder::optionalFieldSize(order.refid().size());
+}
+
+void writeBody(Encoder& encoder, const CancelOrder& order) {
+    encoder.optionalField(1, order.sender());
+    encoder.optionalField(2, order.symbol());
+    encoder.optionalField(3, order.refid());
+}
+
+template <typename Freeze>
+std::size_t freezeSize(const Freeze& order) {
+    return Encoder::optionalFieldSize(order.from().size())
+        + Encoder::optionalFieldSize(order.symbol().size())
+        + Encoder::intFieldSize(order.amount());
+}
+
+template <typename Freeze>
+void writeFreeze(Encoder& encoder, const Freeze& order) {
+    encoder.optionalField(1, order.from());
+    encoder.optionalField(2, order.symbol());
+    encoder.intField(3, order.amount());
+}
+
+std::size_t bodySize(const TokenFreeze& order) { return freezeSize(order); }
+void writeBody(Encoder& encoder, const TokenFreeze& order) { writeFreeze(encoder, order); }
+std::size_t bodySize(const TokenUnfreeze& order) { return freezeSize(order); }
+void writeBody(Encoder& encoder, const TokenUnfreeze& order) { writeFreeze(encoder, order); }
+
+std::size_t tokenSize(const Send_Token& token) {
+    return Encoder::optionalFieldSize(token.denom().size()) + Encoder::intFieldSize(token.amount());
+}
+
+// Send inputs and outputs share one layout.
+template <typename Entry>
+std::size_t entrySize(const Entry& entry) {
+    auto size = Encoder::optionalFieldSize(entry.address().size());
+    for (auto& token : entry.coins()) {
+        size += Encoder::bytesFieldSize(tokenSize(token));
+    }
+    return size;
+}
+
+template <typename Entry>
+void writeEntry(Encoder& encoder, int field, const Entry& entry) {
+    encoder.header(field, entrySize(entry));
+    encoder.optionalField(1, entry.address());
+    for (auto& token : entry.coins()) {
+        encoder.header(2, tokenSize(token));
+        encoder.optionalField(1, token.denom());
+        encoder.intField(2, token.amount());
+    }
+}
+
+std::size_t bodySize(const Send& order) {
+    std::size_t size = 0;
+    for (auto& input : order.inputs()) {
+        size += Encoder::bytesFieldSize(entrySize(input));
+    }
+    for (auto& output : order.outputs()) {
+        size += Encoder::bytesFieldSize(entrySize(output));
+    }
+    return size;
+}
+
+void writeBody(Encoder& encoder, const Send& order) {
+    for (auto& input : order.inputs()) {
+        writeEntry(encoder, 1, input);
+    }
+    for (auto& output : order.outputs()) {
+        writeEntry(encoder, 2, output);
+    }
+}
+
+/// Encoded size of an order, type prefix included.
+template <typename Order>
+std::size_t orderSize(const Order& order) {
+    return prefixSize + bodySize(order);
+}
+
+template <typename Order>
+void writeOrder(Encoder& encoder, const Order& order) {
+    encoder.raw(typePrefix(order), prefixSize);
+    writeBody(encoder, order);
+}
+
+} // namespace
+
+Data Amino::encodePublicKey(const Data& publicKey) {
+    Data encoded(prefixSize + Encoder::varintSize(publicKey.size()) + publicKey.size());
+    auto encoder = Encoder(encoded.data());
+    encoder.raw(pubKeyPrefix, prefixSize);
+    encoder.varint(publicKey.size());
+    encoder.raw(publicKey.data(), publicKey.size());
+    return encoded;
+}
+
+Data Amino::encodeOrder(const ::google::protobuf::Message& order) {
+    Data encoded;
+    visitOrder(order, [&](const auto& typedOrder) {
+        encoded.resize(orderSize(typedOrder));
+        auto encoder = Encoder(encoded.data());
+        writeOrder(encoder, typedOrder);
+    });
+    return encoded;
+}
+
+template <typename Order>
+Data Amino::encodeTransaction(const SignerBase& signer, const Order& order, const Data& signature, const Data& aminoPublicKey) {
+    const auto encodedOrderSize = orderSize(order);
+    const auto signatureSize = Encoder::optionalFieldSize(aminoPublicKey.size())
+        + Encoder::optionalFieldSize(signature.size())
+        + Encoder::intFieldSize(signer.accountNumber)
+        + Encoder::intFieldSize(signer.sequence);
+    const auto transactionSize = prefixSize
+        + Encoder::bytesFieldSize(encodedOrderSize)
+        + Encoder::bytesFieldSize(signatureSize)
+        + Encoder::optionalFieldSize(signer.memo.size())
+        + Encoder::intFieldSize(signer.source);
+
+    Data encoded(Encoder::varintSize(transactionSize) + transactionSize);
+    auto encoder = Encoder(encoded.data());
+    encoder.varint(transactionSize);
+    encoder.raw(transactionPrefix, prefixSize);
+
+    encoder.header(1, encodedOrderSize);
+    writeOrder(encoder, order);
+
+    encoder.header(2, signatureSize);
+    if (!aminoPublicKey.empty()) {
+        encoder.bytesField(1, aminoPublicKey.data(), aminoPublicKey.size());
+    }
+    if (!signature.empty()) {
+        encoder.bytesField(2, signature.data(), signature.size());
+    }
+    encoder.intField(3, signer.accountNumber);
+    encoder.intField(4, signer.sequence);
+
+    encoder.optionalField(3, signer.memo);
+    encoder.intField(4, signer.source);
+    return encoded;
+}
+
+template Data Amino::encodeTransaction(const SignerBase&, const NewOrder&, const Data&, const Data&);
+template Data Amino::encodeTransaction(const SignerBase&, const CancelOrder&, const Data&, const Data&);
+template Data Amino::encodeTransaction(const SignerBase&, const Send&, const Data&, const Data&);
+template Data Amino::encodeTransaction(const SignerBase&, const TokenFreeze&, const Data&, const Data&);
+template Data Amino::encodeTransaction(const SignerBase&, const TokenUnfreeze&, const Data&, const Data&);
+
+Data Amino::encodeTransaction(const Signer& signer, const Data& signature, const Data& aminoPublicKey) {
+    Data encoded;
+    visitOrder(signer.order, [&](const auto& order) {
+        encoded = encodeTransaction(signer, order, signature, aminoPublicKey);
+    });
+    return encoded;
+}
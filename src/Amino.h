@@ -0,0 +1,46 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "dex.pb.h"
+#include "Data.h"
+
+namespace Binance {
+
+class Signer;
+class SignerBase;
+
+namespace Amino {
+
+/// Encodes a compressed public key with its amino type prefix.
+Data encodePublicKey(const Data& publicKey);
+
+/// Encodes an order message with its amino type prefix.
+///
+/// \returns the encoded order, or an empty vector if the message is not an order.
+Data encodeOrder(const ::google::protobuf::Message& order);
+
+/// Encodes a signed transaction, length prefix included.
+///
+/// The exact size is computed up front and every message is written straight into the one output
+/// buffer. The bytes match wrapping each protobuf `SerializeAsString()` output with its amino prefix.
+///
+/// \returns the encoded transaction, or an empty vector if the signer's message is not an order.
+Data encodeTransaction(const Signer& signer, const Data& signature, const Data& aminoPublicKey);
+
+/// Encodes a signed transaction for an order of known type, length prefix included.
+template <typename Order>
+Data encodeTransaction(const SignerBase& signer, const Order& order, const Data& signature, const Data& aminoPublicKey);
+
+extern template Data encodeTransaction(const SignerBase&, const NewOrder&, const Data&, const Data&);
+extern template Data encodeTransaction(const SignerBase&, const CancelOrder&, const Data&, const Data&);
+extern template Data encodeTransaction(const SignerBase&, const Send&, const Data&, const Data&);
+extern template Data encodeTransaction(const SignerBase&, const TokenFreeze&, const Data&, const Data&);
+extern template Data encodeTransaction(const SignerBase&, const TokenUnfreeze&, const Data&, const Data&);
+
+}} // namespace
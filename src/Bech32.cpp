@@ -8,6 +8,8 @@
 
 #include "Bech32.h"
 
+#include <cstring>
+
 using namespace Binance;
 
 namespace {
@@ -27,106 +29,184 @@ const int8_t charset_rev[128] = {
      1,  0,  3, 16, 11, 28, 12, 14,  6,  4,  2, -1, -1, -1, -1, -1
 };
 
-/** Concatenate two byte arrays. */
-Data cat(Data x, const Data& y) {
-    x.insert(x.end(), y.begin(), y.end());
-    return x;
+/** Feed one value into the checksum polynomial. */
+constexpr uint32_t polymod_step(uint32_t chk, uint8_t value) {
+    return (chk & 0x1ffffff) << 5 ^ value ^
+        (-((chk >> 25) & 1) & 0x3b6a57b2UL) ^
+        (-((chk >> 26) & 1) & 0x26508e6dUL) ^
+        (-((chk >> 27) & 1) & 0x1ea119faUL) ^
+        (-((chk >> 28) & 1) & 0x3d4233ddUL) ^
+        (-((chk >> 29) & 1) & 0x2a1462b3UL);
 }
 
-/** Find the polynomial with value coefficients mod the generator as 30-bit. */
-uint32_t polymod(const Data& values) {
+/** Checksum state after the expansion of a lower-case HRP. */
+constexpr uint32_t hrp_checksum(const char* hrp, size_t length) {
     uint32_t chk = 1;
-    for (size_t i = 0; i < values.size(); ++i) {
-        uint8_t top = chk >> 25;
-        chk = (chk & 0x1ffffff) << 5 ^ values[i] ^
-            (-((top >> 0) & 1) & 0x3b6a57b2UL) ^
-            (-((top >> 1) & 1) & 0x26508e6dUL) ^
-            (-((top >> 2) & 1) & 0x1ea119faUL) ^
-            (-((top >> 3) & 1) & 0x3d4233ddUL) ^
-            (-((top >> 4) & 1) & 0x2a1462b3UL);
+    for (size_t i = 0; i < length; ++i) {
+        chk = polymod_step(chk, static_cast<unsigned char>(hrp[i]) >> 5);
+    }
+    chk = polymod_step(chk, 0);
+    for (size_t i = 0; i < length; ++i) {
+        chk = polymod_step(chk, hrp[i] & 0x1f);
     }
     return chk;
 }
 
+/** Expansions of the Binance Chain prefixes, which nearly every address uses. */
+constexpr uint32_t bnb_checksum = hrp_checksum("bnb", 3);
+constexpr uint32_t tbnb_checksum = hrp_checksum("tbnb", 4);
+
+/** Checksum state after the expansion of a valid lower-case HRP. */
+inline uint32_t expand_hrp(const char* hrp, size_t length) {
+    if (length == 3 && std::memcmp(hrp, "bnb", 3) == 0) {
+        return bnb_checksum;
+    }
+    if (length == 4 && std::memcmp(hrp, "tbnb", 4) == 0) {
+        return tbnb_checksum;
+    }
+    return hrp_checksum(hrp, length);
+}
+
 /** Convert to lower case. */
 unsigned char lc(unsigned char c) {
     return (c >= 'A' && c <= 'Z') ? (c - 'A') + 'a' : c;
 }
 
-/** Expand a HRP for use in checksum computation. */
-Data expand_hrp(const std::string& hrp) {
-    Data ret;
-    ret.resize(hrp.size() * 2 + 1);
-    for (size_t i = 0; i < hrp.size(); ++i) {
-        unsigned char c = hrp[i];
-        ret[i] = c >> 5;
-        ret[i + hrp.size() + 1] = c & 0x1f;
+/**
+ * Decode a Bech32 string into its lower-case HRP and its 5-bit values without the checksum. `hrp` and `values`
+ * must hold `maxLength` entries.
+ */
+bool decode_values(const char* str, size_t length, char* hrp, size_t& hrpLength, uint8_t* values, size_t& count) {
+    if (length > Bech32::maxLength) {
+        return false;
+    }
+    bool lower = false, upper = false;
+    size_t pos = length;
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = str[i];
+        if (c < 33 || c > 126) return false;
+        if (c >= 'a' && c <= 'z') lower = true;
+        if (c >= 'A' && c <= 'Z') upper = true;
+        if (c == '1') pos = i;
+    }
+    if (lower && upper) return false;
+    if (pos == length || pos < 1 || pos + 7 > length) {
+        return false;
     }
-    ret[hrp.size()] = 0;
-    return ret;
-}
-
-/** Verify a checksum. */
-bool verify_checksum(const std::string& hrp, const Data& values) {
-    return polymod(cat(expand_hrp(hrp), values)) == 1;
-}
 
-/** Create a checksum. */
-Data create_checksum(const std::string& hrp, const Data& values) {
-    Data enc = cat(expand_hrp(hrp), values);
-    enc.resize(enc.size() + 6);
-    uint32_t mod = polymod(enc) ^ 1;
-    Data ret;
-    ret.resize(6);
-    for (size_t i = 0; i < 6; ++i) {
-        ret[i] = (mod >> (5 * (5 - i))) & 31;
+    for (size_t i = 0; i < pos; ++i) {
+        hrp[i] = lc(str[i]);
     }
-    return ret;
+    hrpLength = pos;
+    uint32_t chk = expand_hrp(hrp, pos);
+    count = length - 1 - pos;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char c = str[i + pos + 1];
+        if (charset_rev[c] == -1) return false;
+        values[i] = charset_rev[c];
+        chk = polymod_step(chk, values[i]);
+    }
+    count -= 6;
+    return chk == 1;
 }
 
 } // namespace
 
 /** Encode a Bech32 string. */
 std::string Bech32::encode(const std::string& hrp, const Data& values) {
-    Data checksum = create_checksum(hrp, values);
-    Data combined = cat(values, checksum);
+    uint32_t chk = expand_hrp(hrp.data(), hrp.size());
     std::string ret = hrp + '1';
-    ret.reserve(ret.size() + combined.size());
-    for (size_t i = 0; i < combined.size(); ++i) {
-        ret += charset[combined[i]];
+    ret.reserve(ret.size() + values.size() + 6);
+    for (size_t i = 0; i < values.size(); ++i) {
+        chk = polymod_step(chk, values[i]);
+        ret += charset[values[i]];
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        chk = polymod_step(chk, 0);
+    }
+    chk ^= 1;
+    for (size_t i = 0; i < 6; ++i) {
+        ret += charset[(chk >> (5 * (5 - i))) & 31];
     }
     return ret;
 }
 
+/** Encode 8-bit data as a Bech32 string into a fixed buffer. */
+std::size_t Bech32::encode(char out[maxLength], const char* hrp, std::size_t hrpLength, const uint8_t* data, std::size_t size) {
+    const auto length = hrpLength + 1 + (size * 8 + 4) / 5 + 6;
+    if (hrpLength == 0 || length > maxLength) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < hrpLength; ++i) {
+        unsigned char c = hrp[i];
+        if (c < 33 || c > 126 || (c >= 'A' && c <= 'Z')) {
+            return 0;
+        }
+        out[i] = c;
+    }
+    uint32_t chk = expand_hrp(hrp, hrpLength);
+
+    auto pos = hrpLength;
+    out[pos++] = '1';
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < size; ++i) {
+        acc = (acc << 8 | data[i]) & 0xfff;
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            const uint8_t value = (acc >> bits) & 31;
+            chk = polymod_step(chk, value);
+            out[pos++] = charset[value];
+        }
+    }
+    if (bits) {
+        const uint8_t value = (acc << (5 - bits)) & 31;
+        chk = polymod_step(chk, value);
+        out[pos++] = charset[value];
+    }
+
+    for (size_t i = 0; i < 6; ++i) {
+        chk = polymod_step(chk, 0);
+    }
+    chk ^= 1;
+    for (size_t i = 0; i < 6; ++i) {
+        out[pos++] = charset[(chk >> (5 * (5 - i))) & 31];
+    }
+    return pos;
+}
+
 /** Decode a Bech32 string. */
 std::pair<std::string, Data> Bech32::decode(const std::string& str) {
-    bool lower = false, upper = false;
-    bool ok = true;
-    for (size_t i = 0; ok && i < str.size(); ++i) {
-        unsigned char c = str[i];
-        if (c < 33 || c > 126) ok = false;
-        if (c >= 'a' && c <= 'z') lower = true;
-        if (c >= 'A' && c <= 'Z') upper = true;
+    char hrp[maxLength];
+    uint8_t values[maxLength];
+    size_t hrpLength, count;
+    if (!decode_values(str.data(), str.size(), hrp, hrpLength, values, count)) {
+        return std::make_pair(std::string(), Data());
     }
-    if (lower && upper) ok = false;
-    size_t pos = str.rfind('1');
-    if (ok && str.size() <= 90 && pos != str.npos && pos >= 1 && pos + 7 <= str.size()) {
-        Data values;
-        values.resize(str.size() - 1 - pos);
-        for (size_t i = 0; i < str.size() - 1 - pos; ++i) {
-            unsigned char c = str[i + pos + 1];
-            if (charset_rev[c] == -1) ok = false;
-            values[i] = charset_rev[c];
-        }
-        if (ok) {
-            std::string hrp;
-            for (size_t i = 0; i < pos; ++i) {
-                hrp += lc(str[i]);
-            }
-            if (verify_checksum(hrp, values)) {
-                return std::make_pair(hrp, Data(values.begin(), values.end() - 6));
-            }
+    return std::make_pair(std::string(hrp, hrpLength), Data(values, values + count));
+}
+
+/** Decode a Bech32 string into 8-bit data in fixed buffers. */
+bool Bech32::decode(const char* str, std::size_t length, char hrp[maxLength], std::size_t& hrpLength, uint8_t data[maxLength], std::size_t& size) {
+    uint8_t values[maxLength];
+    size_t count;
+    if (!decode_values(str, length, hrp, hrpLength, values, count)) {
+        return false;
+    }
+
+    uint32_t acc = 0;
+    int bits = 0;
+    size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        acc = (acc << 5 | values[i]) & 0xfff;
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            data[size++] = (acc >> bits) & 0xff;
         }
     }
-    return std::make_pair(std::string(), Data());
+    // leftover bits must be fewer than 8 and zero, as convertBits<5, 8, false> requires
+    return bits < 5 && ((acc << (8 - bits)) & 0xff) == 0;
 }
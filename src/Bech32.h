@@ -6,25 +6,48 @@
 // redistribution, is contained in the file LICENSE at the root of the source
 // code distribution tree.
 
+#pragma once
+
 #include "Data.h"
 
 #include <stdint.h>
+#include <cstddef>
 #include <vector>
 #include <string>
 
 namespace Binance {
 namespace Bech32 {
 
+/// Maximum length of a Bech32 string.
+constexpr std::size_t maxLength = 90;
+
 /// Encodes a Bech32 string.
 ///
 /// \returns the encoded string, or an empty string in case of failure.
 std::string encode(const std::string& hrp, const Data& values);
 
+/// Encodes 8-bit data as a Bech32 string without allocating.
+///
+/// The data is regrouped into 5-bit values with padding, like `convertBits<8, 5, true>`.
+///
+/// \returns the length of the string written to `out`, which is not null-terminated, or 0 if the human-readable
+///     part is invalid or the string would exceed `maxLength`.
+std::size_t encode(char out[maxLength], const char* hrp, std::size_t hrpLength, const uint8_t* data, std::size_t size);
+
 /// Decodes a Bech32 string.
 ///
 /// \returns a pair with the human-readable part and the data, or a pair or empty collections on failure.
 std::pair<std::string, Data> decode(const std::string& str);
 
+/// Decodes a Bech32 string into 8-bit data without allocating, the inverse of the fixed-buffer `encode`.
+///
+/// The data is regrouped from 5-bit values without padding, like `convertBits<5, 8, false>`.
+///
+/// \param hrp receives the human-readable part in lower case, `hrpLength` characters long.
+/// \param data receives the decoded bytes, `size` of them.
+/// \returns whether the string is valid Bech32 and its padding bits are zero.
+bool decode(const char* str, std::size_t length, char hrp[maxLength], std::size_t& hrpLength, uint8_t data[maxLength], std::size_t& size);
+
 /// Converts from one power-of-2 number base to another.
 template<int frombits, int tobits, bool pad>
 inline bool convertBits(Data& out, const Data& in) {
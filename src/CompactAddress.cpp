@@ -0,0 +1,51 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "CompactAddress.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Binance;
+
+constexpr std::size_t CompactAddress::size;
+
+std::pair<CompactAddress, bool> CompactAddress::fromAddress(const Address& address) {
+    CompactAddress result;
+    if (!Address::networkOf(address.hrp.data(), address.hrp.size(), result.network) || address.keyHash.size() != size) {
+        return std::make_pair(CompactAddress(), false);
+    }
+    std::copy(address.keyHash.begin(), address.keyHash.end(), result.keyHash.begin());
+    return std::make_pair(result, true);
+}
+
+std::pair<CompactAddress, bool> CompactAddress::decode(const std::string& string) {
+    char hrp[Bech32::maxLength];
+    uint8_t keyHash[Bech32::maxLength];
+    std::size_t hrpLength, length;
+    CompactAddress result;
+    if (!Bech32::decode(string.data(), string.size(), hrp, hrpLength, keyHash, length) ||
+        !Address::networkOf(hrp, hrpLength, result.network) || length != size) {
+        return std::make_pair(CompactAddress(), false);
+    }
+    std::copy(keyHash, keyHash + size, result.keyHash.begin());
+    return std::make_pair(result, true);
+}
+
+Address CompactAddress::toAddress() const {
+    return Address(hrp(), Data(keyHash.begin(), keyHash.end()));
+}
+
+std::string CompactAddress::encode() const {
+    char out[Bech32::maxLength];
+    return std::string(out, encode(out));
+}
+
+std::size_t CompactAddress::encode(char out[Bech32::maxLength]) const {
+    const auto prefix = hrp();
+    return Bech32::encode(out, prefix, std::strlen(prefix), keyHash.data(), keyHash.size());
+}
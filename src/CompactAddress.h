@@ -0,0 +1,113 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "Bech32.h"
+#include "HashMix.h"
+
+#include <stdint.h>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Binance {
+
+/// Fixed-size address of a Binance Chain account: a 20-byte key hash and its network.
+///
+/// Unlike `Address` it holds no heap memory and is trivially copyable, hashable and ordered, so maps and sets of
+/// accounts can key on it directly. Addresses order by network first, then by key hash bytes.
+struct CompactAddress {
+    /// Size of a key hash in bytes.
+    static constexpr std::size_t size = 20;
+
+    /// Network the address belongs to.
+    Network network = Network::mainnet;
+
+    /// Public key hash.
+    std::array<uint8_t, size> keyHash = {};
+
+    CompactAddress() = default;
+
+    /// Initializes an address with a key hash.
+    CompactAddress(Network network, const std::array<uint8_t, size>& keyHash) : network(network), keyHash(keyHash) {}
+
+    /// Converts an `Address`.
+    ///
+    /// \returns a pair with the address and a success flag, which is false if `address` is not on a Binance Chain
+    ///     network or its key hash is not 20 bytes long.
+    static std::pair<CompactAddress, bool> fromAddress(const Address& address);
+
+    /// Decodes an address string.
+    ///
+    /// \returns a pair with the address and a success flag.
+    static std::pair<CompactAddress, bool> decode(const std::string& string);
+
+    /// Human-readable part of the address.
+    const char* hrp() const {
+        return network == Network::testnet ? Address::binanceTestHRP : Address::binanceHRP;
+    }
+
+    /// Converts to an `Address`.
+    Address toAddress() const;
+
+    /// Encodes the address.
+    std::string encode() const;
+
+    /// Encodes the address into a fixed buffer, without allocating.
+    ///
+    /// \returns the length of the address written to `out`.
+    std::size_t encode(char out[Bech32::maxLength]) const;
+
+    bool operator==(const CompactAddress& rhs) const {
+        return network == rhs.network && keyHash == rhs.keyHash;
+    }
+
+    bool operator!=(const CompactAddress& rhs) const {
+        return !(*this == rhs);
+    }
+
+    bool operator<(const CompactAddress& rhs) const {
+        return std::tie(network, keyHash) < std::tie(rhs.network, rhs.keyHash);
+    }
+
+    bool operator>(const CompactAddress& rhs) const {
+        return rhs < *this;
+    }
+
+    bool operator<=(const CompactAddress& rhs) const {
+        return !(rhs < *this);
+    }
+
+    bool operator>=(const CompactAddress& rhs) const {
+        return !(*this < rhs);
+    }
+};
+
+static_assert(std::is_trivially_copyable<CompactAddress>::value, "CompactAddress must be trivially copyable");
+
+} // namespace
+
+namespace std {
+
+/// Hashes a `CompactAddress` by all of its key hash bytes and its network with the keyed `hashBytes`.
+///
+/// Key hashes of order recipients are chosen by other parties, who cannot predict the buckets without the key.
+template <>
+struct hash<Binance::CompactAddress> {
+    std::size_t operator()(const Binance::CompactAddress& address) const {
+        const auto seed = static_cast<uint64_t>(address.network);
+        return static_cast<std::size_t>(Binance::hashBytes<Binance::CompactAddress::size>(address.keyHash.data(), seed));
+    }
+};
+
+} // namespace std
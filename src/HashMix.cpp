@@ -0,0 +1,24 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HashMix.h"
+
+#include "crypto/rand.h"
+
+using namespace Binance;
+
+const HashKey& Binance::hashKey() {
+    static const HashKey key = [] {
+        uint8_t bytes[16];
+        random_buffer(bytes, sizeof(bytes));
+        HashKey result;
+        std::memcpy(&result.k0, bytes, 8);
+        std::memcpy(&result.k1, bytes + 8, 8);
+        return result;
+    }();
+    return key;
+}
@@ -0,0 +1,72 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+namespace Binance {
+
+/// Secret key of `hashBytes`, drawn from `random_buffer` once per process.
+struct HashKey {
+    uint64_t k0;
+    uint64_t k1;
+};
+
+/// Returns the process-wide key of `hashBytes`.
+const HashKey& hashKey();
+
+/// SipHash-1-3 of `size` bytes under the key `k0`, `k1`.
+template <std::size_t size>
+inline uint64_t sipHash13(const uint8_t* data, uint64_t k0, uint64_t k1) {
+    const auto rotate = [](uint64_t x, int bits) { return (x << bits) | (x >> (64 - bits)); };
+    uint64_t v0 = k0 ^ 0x736f6d6570736575;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6d;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261;
+    uint64_t v3 = k1 ^ 0x7465646279746573;
+    const auto round = [&] {
+        v0 += v1; v1 = rotate(v1, 13); v1 ^= v0; v0 = rotate(v0, 32);
+        v2 += v3; v3 = rotate(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotate(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotate(v1, 17); v1 ^= v2; v2 = rotate(v2, 32);
+    };
+    const auto compress = [&](uint64_t word) {
+        v3 ^= word;
+        round();
+        v0 ^= word;
+    };
+
+    for (std::size_t i = 0; i < size / 8; i += 1) {
+        uint64_t word;
+        std::memcpy(&word, data + 8 * i, 8);
+        compress(word);
+    }
+    uint64_t last = 0;
+    std::memcpy(&last, data + size - size % 8, size % 8);
+    compress(last | static_cast<uint64_t>(size) << 56);
+
+    v2 ^= 0xff;
+    round();
+    round();
+    round();
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/// Hashes `size` bytes for the hash tables of this library.
+///
+/// The hash is SipHash-1-3 keyed with a random per-process key, with `tweak` mixed into the key so that values
+/// such as a network separate otherwise equal byte strings. Without the key, the buckets that byte strings land
+/// in cannot be predicted, so keys that other parties choose cannot be made to collide on purpose.
+template <std::size_t size>
+inline uint64_t hashBytes(const uint8_t* data, uint64_t tweak = 0) {
+    const auto& key = hashKey();
+    return sipHash13<size>(data, key.k0, key.k1 ^ tweak);
+}
+
+} // namespace
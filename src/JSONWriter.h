@@ -0,0 +1,180 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Sink.h"
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace Binance {
+
+/// Minimal JSON emitter for canonical sign bytes.
+///
+/// Callers write keys and punctuation as literals in sorted-key order; the writer only formats values.
+/// Strings are escaped exactly like `nlohmann::json::dump()` so the output is byte-identical to it.
+///
+/// Output is staged in a small internal buffer and handed to the sink in chunks; call `flush()` once
+/// the document is complete.
+class JSONWriter {
+public:
+    /// Initializes a writer that streams into `sink`.
+    explicit JSONWriter(Sink& sink) : sink(sink), used(0) {}
+
+    JSONWriter(const JSONWriter&) = delete;
+    JSONWriter& operator=(const JSONWriter&) = delete;
+
+    /// Hands any staged output to the sink.
+    void flush() {
+        if (used != 0) {
+            sink.write(buffer, used);
+            used = 0;
+        }
+    }
+
+    /// Appends raw bytes, such as punctuation and quoted keys.
+    template <std::size_t N>
+    void raw(const char (&literal)[N]) {
+        append(literal, N - 1);
+    }
+
+    /// Appends a quoted, escaped string.
+    ///
+    /// \throws std::invalid_argument if the string is not valid UTF-8.
+    void string(const std::string& value) {
+        string(value.data(), value.size());
+    }
+
+    /// Appends a quoted, escaped string of `size` bytes.
+    ///
+    /// \throws std::invalid_argument if the string is not valid UTF-8.
+    void string(const char* data, std::size_t size) {
+        put('"');
+        escape(data, size);
+        put('"');
+    }
+
+    /// Appends a decimal integer.
+    void integer(int64_t value) {
+        char digits[20];
+        auto magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        auto end = digits + sizeof(digits);
+        auto begin = end;
+        do {
+            *--begin = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) {
+            put('-');
+        }
+        append(begin, end - begin);
+    }
+
+    /// Appends a decimal integer as a quoted string.
+    void quotedInteger(int64_t value) {
+        put('"');
+        integer(value);
+        put('"');
+    }
+
+private:
+    static const std::size_t capacity = 256;
+
+    Sink& sink;
+    char buffer[capacity];
+    std::size_t used;
+
+    void put(char c) {
+        if (used == capacity) {
+            flush();
+        }
+        buffer[used++] = c;
+    }
+
+    void append(const char* data, std::size_t size) {
+        if (size > capacity - used) {
+            flush();
+            if (size >= capacity) {
+                sink.write(data, size);
+                return;
+            }
+        }
+        std::memcpy(buffer + used, data, size);
+        used += size;
+    }
+
+    void escape(const char* data, std::size_t size) {
+        static const char hexmap[] = "0123456789abcdef";
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < size; i += 1) {
+            const auto c = static_cast<unsigned char>(data[i]);
+            if (c >= 0x80) {
+                const auto length = utf8SequenceLength(data + i, size - i);
+                if (length == 0) {
+                    throw std::invalid_argument("Invalid UTF-8 string");
+                }
+                i += length - 1;
+                continue;
+            }
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            append(data + run, i - run);
+            run = i + 1;
+            put('\\');
+            switch (c) {
+            case '"': put('"'); break;
+            case '\\': put('\\'); break;
+            case '\b': put('b'); break;
+            case '\f': put('f'); break;
+            case '\n': put('n'); break;
+            case '\r': put('r'); break;
+            case '\t': put('t'); break;
+            default:
+                append("u00", 3);
+                put(hexmap[c >> 4]);
+                put(hexmap[c & 0x0f]);
+                break;
+            }
+        }
+        append(data + run, size - run);
+    }
+
+    /// Returns the length of the well-formed UTF-8 sequence at `data`, or zero if it is malformed.
+    static std::size_t utf8SequenceLength(const char* data, std::size_t available) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+        std::size_t length;
+        unsigned char low = 0x80, high = 0xBF;
+        if (bytes[0] >= 0xC2 && bytes[0] <= 0xDF) {
+            length = 2;
+        } else if (bytes[0] >= 0xE0 && bytes[0] <= 0xEF) {
+            length = 3;
+            if (bytes[0] == 0xE0) low = 0xA0;
+            if (bytes[0] == 0xED) high = 0x9F;
+        } else if (bytes[0] >= 0xF0 && bytes[0] <= 0xF4) {
+            length = 4;
+            if (bytes[0] == 0xF0) low = 0x90;
+            if (bytes[0] == 0xF4) high = 0x8F;
+        } else {
+            return 0;
+        }
+        if (available < length || bytes[1] < low || bytes[1] > high) {
+            return 0;
+        }
+        for (std::size_t i = 2; i < length; i += 1) {
+            if (bytes[i] < 0x80 || bytes[i] > 0xBF) {
+                return 0;
+            }
+        }
+        return length;
+    }
+};
+
+} // namespace
@@ -0,0 +1,39 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "dex.pb.h"
+
+namespace Binance {
+
+/// Calls `visitor` with an order message cast to its concrete type.
+///
+/// The type is resolved by comparing descriptor pointers, once, so the visitor can use
+/// compile-time overloads for the rest of the work.
+///
+/// \returns `false` if the message is not one of the order types.
+template <typename Visitor>
+bool visitOrder(const ::google::protobuf::Message& order, Visitor&& visitor) {
+    const auto descriptor = order.GetDescriptor();
+    if (descriptor == NewOrder::descriptor()) {
+        visitor(static_cast<const NewOrder&>(order));
+    } else if (descriptor == CancelOrder::descriptor()) {
+        visitor(static_cast<const CancelOrder&>(order));
+    } else if (descriptor == Send::descriptor()) {
+        visitor(static_cast<const Send&>(order));
+    } else if (descriptor == TokenFreeze::descriptor()) {
+        visitor(static_cast<const TokenFreeze&>(order));
+    } else if (descriptor == TokenUnfreeze::descriptor()) {
+        visitor(static_cast<const TokenUnfreeze&>(order));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
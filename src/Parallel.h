@@ -0,0 +1,80 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Binance {
+
+/// Resolves a requested worker count, `0` meaning one worker per hardware thread.
+inline unsigned workerCount(unsigned threads, std::size_t count) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, count)));
+}
+
+/// Calls `body(begin, end)` over consecutive chunks of `[0, count)` on up to `threads` workers.
+///
+/// Every index is visited exactly once, so results written by index come out in a deterministic order
+/// regardless of scheduling. The calling thread takes part in the work. The first exception thrown by
+/// `body` is rethrown once all workers have stopped.
+template <typename Body>
+void parallelFor(std::size_t count, unsigned threads, std::size_t chunk, Body&& body) {
+    if (count == 0) {
+        return;
+    }
+    chunk = std::max<std::size_t>(1, chunk);
+    const auto workers = workerCount(threads, (count + chunk - 1) / chunk);
+    if (workers == 1) {
+        body(std::size_t(0), count);
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto run = [&]() {
+        try {
+            for (;;) {
+                const auto begin = next.fetch_add(chunk);
+                if (begin >= count) {
+                    break;
+                }
+                body(begin, std::min(begin + chunk, count));
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next.store(count);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned i = 1; i < workers; i += 1) {
+        pool.emplace_back(run);
+    }
+    run();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace
@@ -6,64 +6,218 @@
 // code distribution tree.
 
 #include "Serialization.h"
+#include "SerializationJSON.h"
 
-#include "Address.h"
+#include "AddressCache.h"
+#include "JSONWriter.h"
+#include "Orders.h"
 #include "Signer.h"
 
 using namespace Binance;
 using json = nlohmann::json;
 
+// Encodes the key hash of an address field, reusing the strings of accounts that sign repeatedly.
+static inline std::size_t encodeAddress(char out[Bech32::maxLength], const std::string& bytes) {
+    return AddressCache::shared().encode(out, Network::mainnet, reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+}
+
 static inline std::string addressString(const std::string& bytes) {
-    auto data = std::vector<uint8_t>(bytes.begin(), bytes.end());
-    auto address = Address(Address::binanceHRP, data);
-    return address.encode();
+    char address[Bech32::maxLength];
+    const auto length = encodeAddress(address, bytes);
+    return std::string(address, length);
+}
+
+static inline void writeAddress(JSONWriter& writer, const std::string& bytes) {
+    char address[Bech32::maxLength];
+    const auto length = encodeAddress(address, bytes);
+    writer.string(address, length);
+}
+
+// Each writer emits its keys in sorted order, matching the canonical JSON the chain signs.
+
+static void writeTokens(JSONWriter& writer, const ::google::protobuf::RepeatedPtrField<Binance::Send_Token>& tokens) {
+    writer.raw("[");
+    for (auto i = 0; i < tokens.size(); i += 1) {
+        if (i != 0) {
+            writer.raw(",");
+        }
+        writer.raw("{\"amount\":");
+        writer.integer(tokens[i].amount());
+        writer.raw(",\"denom\":");
+        writer.string(tokens[i].denom());
+        writer.raw("}");
+    }
+    writer.raw("]");
+}
+
+template <typename Entries>
+static void writeEntries(JSONWriter& writer, const Entries& entries) {
+    writer.raw("[");
+    for (auto i = 0; i < entries.size(); i += 1) {
+        if (i != 0) {
+            writer.raw(",");
+        }
+        writer.raw("{\"address\":");
+        writeAddress(writer, entries[i].address());
+        writer.raw(",\"coins\":");
+        writeTokens(writer, entries[i].coins());
+        writer.raw("}");
+    }
+    writer.raw("]");
+}
+
+static void writeOrder(JSONWriter& writer, const NewOrder& order) {
+    writer.raw("{\"id\":");
+    writer.string(order.id());
+    writer.raw(",\"ordertype\":2,\"price\":");
+    writer.integer(order.price());
+    writer.raw(",\"quantity\":");
+    writer.integer(order.quantity());
+    writer.raw(",\"sender\":");
+    writeAddress(writer, order.sender());
+    writer.raw(",\"side\":");
+    writer.integer(order.side());
+    writer.raw(",\"symbol\":");
+    writer.string(order.symbol());
+    writer.raw(",\"timeinforce\":");
+    writer.integer(order.timeinforce());
+    writer.raw("}");
+}
+
+static void writeOrder(JSONWriter& writer, const CancelOrder& order) {
+    writer.raw("{\"refid\":");
+    writer.string(order.refid());
+    writer.raw(",\"sender\":");
+    writer.string(order.sender());
+    writer.raw(",\"symbol\":");
+    writer.string(order.symbol());
+    writer.raw("}");
+}
+
+static void writeOrder(JSONWriter& writer, const Send& order) {
+    writer.raw("{\"inputs\":");
+    writeEntries(writer, order.inputs());
+    writer.raw(",\"outputs\":");
+    writeEntries(writer, order.outputs());
+    writer.raw("}");
+}
+
+template <typename Freeze>
+static void writeFreeze(JSONWriter& writer, const Freeze& order) {
+    writer.raw("{\"amount\":");
+    writer.integer(order.amount());
+    writer.raw(",\"from\":");
+    writeAddress(writer, order.from());
+    writer.raw(",\"symbol\":");
+    writer.string(order.symbol());
+    writer.raw("}");
+}
+
+static void writeOrder(JSONWriter& writer, const TokenFreeze& order) {
+    writeFreeze(writer, order);
+}
+
+static void writeOrder(JSONWriter& writer, const TokenUnfreeze& order) {
+    writeFreeze(writer, order);
+}
+
+template <typename Order>
+void Binance::writeSignaturePreimage(const SignerBase& signer, const Order& order, Sink& sink) {
+    JSONWriter writer(sink);
+    writer.raw("{\"account_number\":");
+    writer.quotedInteger(signer.accountNumber);
+    writer.raw(",\"chain_id\":");
+    writer.string(signer.chainId);
+    writer.raw(",\"data\":null,\"memo\":");
+    writer.string(signer.memo);
+    writer.raw(",\"msgs\":[");
+    writeOrder(writer, order);
+    writer.raw("],\"sequence\":");
+    writer.quotedInteger(signer.sequence);
+    writer.raw(",\"source\":");
+    writer.quotedInteger(signer.source);
+    writer.raw("}");
+    writer.flush();
+}
+
+template void Binance::writeSignaturePreimage(const SignerBase&, const NewOrder&, Sink&);
+template void Binance::writeSignaturePreimage(const SignerBase&, const CancelOrder&, Sink&);
+template void Binance::writeSignaturePreimage(const SignerBase&, const Send&, Sink&);
+template void Binance::writeSignaturePreimage(const SignerBase&, const TokenFreeze&, Sink&);
+template void Binance::writeSignaturePreimage(const SignerBase&, const TokenUnfreeze&, Sink&);
+
+void Binance::writeSignaturePreimage(const Signer& signer, Sink& sink) {
+    auto valid = visitOrder(signer.order, [&](const auto& order) {
+        writeSignaturePreimage(signer, order, sink);
+    });
+    if (!valid) {
+        throw std::invalid_argument("Invalid order type");
+    }
+}
+
+void Binance::writeSignaturePreimage(const Signer& signer, std::string& out) {
+    out.clear();
+    StringSink sink(out);
+    writeSignaturePreimage(signer, sink);
 }
 
 std::string Binance::signaturePreimage(const Signer& signer) {
+    std::string preImage;
+    writeSignaturePreimage(signer, preImage);
+    return preImage;
+}
+
+static json typedOrderJSON(const NewOrder& tradeOrder) {
+    json j;
+    j["id"] = tradeOrder.id();
+    j["ordertype"] = 2;
+    j["price"] = tradeOrder.price();
+    j["quantity"] = tradeOrder.quantity();
+    j["sender"] = addressString(tradeOrder.sender());
+    j["side"] = tradeOrder.side();
+    j["symbol"] = tradeOrder.symbol();
+    j["timeinforce"] = tradeOrder.timeinforce();
+    return j;
+}
+
+static json typedOrderJSON(const CancelOrder& cancelOrder) {
     json j;
-    j["account_number"] = std::to_string(signer.accountNumber);
-    j["chain_id"] = signer.chainId;
-    j["data"] = nullptr;
-    j["memo"] = signer.memo;
-    j["msgs"] = json::array({ orderJSON(signer.order) });
-    j["sequence"] = std::to_string(signer.sequence);
-    j["source"] = std::to_string(signer.source);
-    return j.dump();
+    j["refid"] = cancelOrder.refid();
+    j["sender"] = cancelOrder.sender();
+    j["symbol"] = cancelOrder.symbol();
+    return j;
+}
+
+static json typedOrderJSON(const Send& send) {
+    json j;
+    j["inputs"] = inputsJSON(send);
+    j["outputs"] = outputsJSON(send);
+    return j;
+}
+
+template <typename Freeze>
+static json freezeJSON(const Freeze& freeze) {
+    json j;
+    j["from"] = addressString(freeze.from());
+    j["symbol"] = freeze.symbol();
+    j["amount"] = freeze.amount();
+    return j;
+}
+
+static json typedOrderJSON(const TokenFreeze& freeze) {
+    return freezeJSON(freeze);
+}
+
+static json typedOrderJSON(const TokenUnfreeze& unfreeze) {
+    return freezeJSON(unfreeze);
 }
 
 json Binance::orderJSON(const ::google::protobuf::Message& order) {
     json j;
-    const auto typeName = order.GetTypeName();
-    if (typeName == NewOrder::descriptor()->full_name()) {
-        auto tradeOrder = reinterpret_cast<const NewOrder&>(order);
-        j["id"] = tradeOrder.id();
-        j["ordertype"] = 2;
-        j["price"] = tradeOrder.price();
-        j["quantity"] = tradeOrder.quantity();
-        j["sender"] = addressString(tradeOrder.sender());
-        j["side"] = tradeOrder.side();
-        j["symbol"] = tradeOrder.symbol();
-        j["timeinforce"] = tradeOrder.timeinforce();
-    } else if (typeName == CancelOrder::descriptor()->full_name()) {
-        auto cancelOrder = reinterpret_cast<const CancelOrder&>(order);
-        j["refid"] = cancelOrder.refid();
-        j["sender"] = cancelOrder.sender();
-        j["symbol"] = cancelOrder.symbol();
-    } else if (typeName == Send::descriptor()->full_name()) {
-        auto send = reinterpret_cast<const Send&>(order);
-        j["inputs"] = inputsJSON(send);
-        j["outputs"] = outputsJSON(send);
-    } else if (typeName == TokenFreeze::descriptor()->full_name()) {
-        auto freeze = reinterpret_cast<const TokenFreeze&>(order);
-        j["from"] = addressString(freeze.from());
-        j["symbol"] = freeze.symbol();
-        j["amount"] = freeze.amount();
-    } else if (typeName == TokenUnfreeze::descriptor()->full_name()) {
-        auto unfreeze = reinterpret_cast<const TokenUnfreeze&>(order);
-        j["from"] = addressString(unfreeze.from());
-        j["symbol"] = unfreeze.symbol();
-        j["amount"] = unfreeze.amount();
-    } else {
+    auto valid = visitOrder(order, [&](const auto& typedOrder) {
+        j = typedOrderJSON(typedOrder);
+    });
+    if (!valid) {
         throw std::invalid_argument("Invalid order type");
     }
     return j;
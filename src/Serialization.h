@@ -8,16 +8,38 @@
 #pragma once
 
 #include "dex.pb.h"
-#include <nlohmann/json.hpp>
+#include "Sink.h"
+
+#include <string>
 
 namespace Binance {
 
 class Signer;
+class SignerBase;
+
+/// Streams the canonical sign bytes of a transaction into `sink`.
+///
+/// The output is byte-identical to `signaturePreimage`, but it is never held in memory as a whole,
+/// so a hashing sink can digest it as it is produced.
+///
+/// \throws std::invalid_argument if the signer's message is not an order.
+void writeSignaturePreimage(const Signer& signer, Sink& sink);
+
+/// Streams the canonical sign bytes of a transaction for an order of known type into `sink`.
+template <typename Order>
+void writeSignaturePreimage(const SignerBase& signer, const Order& order, Sink& sink);
+
+extern template void writeSignaturePreimage(const SignerBase&, const NewOrder&, Sink&);
+extern template void writeSignaturePreimage(const SignerBase&, const CancelOrder&, Sink&);
+extern template void writeSignaturePreimage(const SignerBase&, const Send&, Sink&);
+extern template void writeSignaturePreimage(const SignerBase&, const TokenFreeze&, Sink&);
+extern template void writeSignaturePreimage(const SignerBase&, const TokenUnfreeze&, Sink&);
+
+/// Writes the canonical sign bytes of a transaction, replacing the contents of `out`.
+///
+/// A buffer reused across calls avoids any per-transaction allocation.
+void writeSignaturePreimage(const Signer& signer, std::string& out);
 
 std::string signaturePreimage(const Signer& signer);
-nlohmann::json orderJSON(const ::google::protobuf::Message& order);
-nlohmann::json inputsJSON(const Binance::Send& order);
-nlohmann::json outputsJSON(const Binance::Send& order);
-nlohmann::json tokensJSON(const ::google::protobuf::RepeatedPtrField<Binance::Send_Token>& tokens);
 
 } // namespace
@@ -0,0 +1,22 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "dex.pb.h"
+#include <nlohmann/json.hpp>
+
+namespace Binance {
+
+// JSON documents of orders, kept apart from `Serialization.h` so that only their users need the nlohmann headers.
+
+nlohmann::json orderJSON(const ::google::protobuf::Message& order);
+nlohmann::json inputsJSON(const Binance::Send& order);
+nlohmann::json outputsJSON(const Binance::Send& order);
+nlohmann::json tokensJSON(const ::google::protobuf::RepeatedPtrField<Binance::Send_Token>& tokens);
+
+} // namespace
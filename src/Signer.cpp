@@ -6,125 +6,236 @@
 // code distribution tree.
 
 #include "Signer.h"
+#include "Amino.h"
+#include "Parallel.h"
 #include "Serialization.h"
 
 #include "crypto/ecdsa.h"
+#include "crypto/memzero.h"
 #include "crypto/secp256k1.h"
 #include "crypto/sha2.h"
 
-#include <nlohmann/json.hpp>
-#include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <algorithm>
+#include <map>
 #include <string>
 
 using namespace Binance;
 
-// Message prefixes
-static const auto sendOrderPrefix = Data{ 0x2A, 0x2C, 0x87, 0xFA };
-static const auto tradeOrderPrefix = Data{ 0xCE, 0x6D, 0xC0, 0x43 };
-static const auto cancelTradeOrderPrefix = Data{ 0x16, 0x6E, 0x68, 0x1B };
-static const auto tokenFreezeOrderPrefix = Data{ 0xE7, 0x74, 0xB3, 0x2D };
-static const auto tokenUnfreezeOrderPrefix = Data{ 0x65, 0x15, 0xFF, 0x0D };
-static const auto pubKeyPrefix = Data{ 0xEB, 0x5A, 0xE9, 0x87 };
-static const auto transactionPrefix = Data{ 0xF0, 0x62, 0x5D, 0xEE };
+// Number of transactions a batch worker claims at a time.
+static const std::size_t batchChunkSize = 16;
 
-Data Signer::build() const {
-    auto signature = sign();
-    if (signature.empty()) {
-        return {};
+// Resolves the amino-encoded public key of every signer, deriving each distinct raw private key once.
+//
+// Only the public keys are derived, in batches of `batchChunkSize` that share their scalar multiplications.
+// Entries point into the signer's `signingKey` or into `derived`, and are null for signers whose private key is
+// invalid.
+static std::vector<const Data*> batchAminoPublicKeys(const std::vector<Signer>& signers, unsigned threads, std::vector<Data>& derived) {
+    std::map<Data, std::size_t> index;
+    std::vector<const Data*> privateKeys;
+    std::vector<std::size_t> keyIndex;
+    keyIndex.reserve(signers.size());
+    for (auto& signer : signers) {
+        if (signer.signingKey) {
+            keyIndex.push_back(0);
+            continue;
+        }
+        auto it = index.emplace(signer.privateKey, privateKeys.size());
+        if (it.second) {
+            privateKeys.push_back(&signer.privateKey);
+        }
+        keyIndex.push_back(it.first->second);
     }
 
-    auto encoded = encodeSignature(signature);
-    return encodeTransaction(encoded);
-}
-
-Data Signer::sign() const {
-    const auto preImage = signaturePreimage(*this);
+    std::vector<std::size_t> valid;
+    for (std::size_t i = 0; i < privateKeys.size(); i += 1) {
+        if (SigningKey::isValid(*privateKeys[i])) {
+            valid.push_back(i);
+        }
+    }
 
-    byte hash[SHA256_DIGEST_LENGTH];
-    sha256_Raw(reinterpret_cast<const byte*>(preImage.data()), preImage.size(), hash);
+    derived.assign(privateKeys.size(), Data());
+    parallelFor(valid.size(), threads, batchChunkSize, [&](std::size_t begin, std::size_t end) {
+        for (auto chunk = begin; chunk < end; chunk += batchChunkSize) {
+            const auto count = std::min(batchChunkSize, end - chunk);
+            byte keys[32 * batchChunkSize];
+            byte publicKeys[33 * batchChunkSize];
+            for (std::size_t j = 0; j < count; j += 1) {
+                const auto& key = *privateKeys[valid[chunk + j]];
+                std::copy(key.begin(), key.end(), keys + 32 * j);
+            }
+            ecdsa_get_public_key33_batch(&secp256k1, keys, count, publicKeys);
+            memzero(keys, sizeof(keys));
+            for (std::size_t j = 0; j < count; j += 1) {
+                const auto publicKey = publicKeys + 33 * j;
+                derived[valid[chunk + j]] = Amino::encodePublicKey(Data(publicKey, publicKey + 33));
+            }
+        }
+    });
+
+    std::vector<const Data*> keys;
+    keys.reserve(signers.size());
+    for (std::size_t i = 0; i < signers.size(); i += 1) {
+        if (signers[i].signingKey) {
+            keys.push_back(&signers[i].signingKey->aminoPublicKey);
+        } else {
+            const auto& key = derived[keyIndex[i]];
+            keys.push_back(key.empty() ? nullptr : &key);
+        }
+    }
+    return keys;
+}
 
+Data SignerBase::signDigest(const byte digest[SHA256_DIGEST_LENGTH]) const {
     byte sig[64];
-    if (-1 == ecdsa_sign_digest(&secp256k1, privateKey.data(), hash, sig, nullptr, nullptr)) {
+    const auto result = signingKey
+        ? ecdsa_sign_digest_key(&secp256k1, &signingKey->nonceKey, digest, sig, nullptr, nullptr)
+        : ecdsa_sign_digest(&secp256k1, privateKey.data(), digest, sig, nullptr, nullptr);
+    if (-1 == result) {
         return {};
     }
 
     return Data(sig, sig + 64);
 }
 
-Data Signer::encodeTransaction(const Data& signature) const {
-    auto msg = encodeOrder();
-    auto transaction = Binance::Transaction();
-    transaction.add_msgs(msg.data(), msg.size());
-    transaction.add_signatures(signature.data(), signature.size());
-    transaction.set_memo(memo);
-    transaction.set_source(source);
-    
-    auto data = transaction.SerializeAsString();
-    return aminoWrap(data, transactionPrefix, true);
+Data SignerBase::aminoPublicKey() const {
+    if (signingKey) {
+        return signingKey->aminoPublicKey;
+    }
+    if (!SigningKey::isValid(privateKey)) {
+        return {};
+    }
+    Data publicKey(33);
+    ecdsa_get_public_key33(&secp256k1, privateKey.data(), publicKey.data());
+    return Amino::encodePublicKey(publicKey);
 }
 
-Data Signer::encodeOrder() const {
-    std::string data;
-    Data prefix;
-    const auto typeName = order.GetTypeName();
-    if (typeName == NewOrder::descriptor()->full_name()) {
-        data = order.SerializeAsString();
-        prefix = tradeOrderPrefix;
-    } else if (typeName == CancelOrder::descriptor()->full_name()) {
-        data = order.SerializeAsString();
-        prefix = cancelTradeOrderPrefix;
-    } else if (typeName == Send::descriptor()->full_name()) {
-        data = order.SerializeAsString();
-        prefix = sendOrderPrefix;
-    } else if (typeName == TokenFreeze::descriptor()->full_name()) {
-        data = order.SerializeAsString();
-        prefix = tokenFreezeOrderPrefix;
-    } else if (typeName == TokenUnfreeze::descriptor()->full_name()) {
-        data = order.SerializeAsString();
-        prefix = tokenUnfreezeOrderPrefix;
-    } else {
+Data Signer::build() const {
+    auto signature = sign();
+    if (signature.empty()) {
         return {};
     }
-    return aminoWrap(data, prefix, false);
-}
 
-Data Signer::encodeSignature(const Data& signature) const {
-    Data publicKey;
-    publicKey.resize(33);
-    ecdsa_get_public_key33(&secp256k1, privateKey.data(), publicKey.data());
+    const auto publicKey = aminoPublicKey();
+    if (publicKey.empty()) {
+        return {};
+    }
+    return Amino::encodeTransaction(*this, signature, publicKey);
+}
 
-    auto encodedPublicKey = pubKeyPrefix;
-    encodedPublicKey.insert(encodedPublicKey.end(), static_cast<uint8_t>(publicKey.size()));
-    encodedPublicKey.insert(encodedPublicKey.end(), publicKey.begin(), publicKey.end());
+Data Signer::sign() const {
+    byte hash[SHA256_DIGEST_LENGTH];
+    signatureDigest(hash);
+    return signDigest(hash);
+}
 
-    auto object = Binance::Signature();
-    object.set_pub_key(encodedPublicKey.data(), encodedPublicKey.size());
-    object.set_signature(signature.data(), signature.size());
-    object.set_account_number(accountNumber);
-    object.set_sequence(sequence);
+Data Signer::sign(std::string& preimage) const {
+    preimage.clear();
+    byte hash[SHA256_DIGEST_LENGTH];
+    signatureDigest(hash, &preimage);
+    return signDigest(hash);
+}
 
-    return aminoWrap(object.SerializeAsString(), {}, false);
+void Signer::signatureDigest(byte digest[SHA256_DIGEST_LENGTH], std::string* preimage) const {
+    auto sink = SHA256Sink(preimage);
+    writeSignaturePreimage(*this, sink);
+    sink.finish(digest);
 }
 
-Data Signer::aminoWrap(const std::string& raw, const Data& typePrefix, bool prefixWithSize) const {
-    const auto contentsSize = raw.size() + typePrefix.size();
-    auto size = contentsSize;
-    if (prefixWithSize) {
-        size += 10;
+void Signer::signRange(const std::vector<Signer>& signers, std::size_t begin, std::size_t end, std::vector<Data>& signatures) {
+    for (auto chunk = begin; chunk < end; chunk += batchChunkSize) {
+        byte privateKeys[32 * batchChunkSize];
+        byte digests[SHA256_DIGEST_LENGTH * batchChunkSize];
+        byte sigs[64 * batchChunkSize];
+        std::size_t index[batchChunkSize];
+        std::size_t count = 0;
+        for (auto i = chunk; i < std::min(chunk + batchChunkSize, end); i += 1) {
+            const auto& signer = signers[i];
+            const auto& key = signer.signingKey ? signer.signingKey->privateKey : signer.privateKey;
+            if (!SigningKey::isValid(key)) {
+                signatures[i] = signer.sign();
+                continue;
+            }
+            std::copy(key.begin(), key.end(), privateKeys + 32 * count);
+            signer.signatureDigest(digests + SHA256_DIGEST_LENGTH * count);
+            index[count] = i;
+            count += 1;
+        }
+
+        const auto failed = ecdsa_sign_digest_batch(&secp256k1, privateKeys, digests, count, sigs, nullptr) != 0;
+        memzero(privateKeys, sizeof(privateKeys));
+        for (std::size_t j = 0; j < count; j += 1) {
+            const auto sig = sigs + 64 * j;
+            if (failed && std::all_of(sig, sig + 64, [](byte b) { return b == 0; })) {
+                continue;
+            }
+            signatures[index[j]] = Data(sig, sig + 64);
+        }
     }
+}
 
-    std::string msg;
-    msg.reserve(size);
-    {
-        google::protobuf::io::StringOutputStream output(&msg);
-        google::protobuf::io::CodedOutputStream cos(&output);
-        if (prefixWithSize) {
-            cos.WriteVarint64(contentsSize);
+std::vector<Data> Signer::signBatch(const std::vector<Signer>& signers, unsigned threads) {
+    std::vector<Data> signatures(signers.size());
+    parallelFor(signers.size(), threads, batchChunkSize, [&](std::size_t begin, std::size_t end) {
+        signRange(signers, begin, end, signatures);
+    });
+    return signatures;
+}
+
+std::vector<Data> Signer::buildBatch(const std::vector<Signer>& signers, unsigned threads) {
+    std::vector<Data> derived;
+    const auto publicKeys = batchAminoPublicKeys(signers, threads, derived);
+    std::vector<Data> signatures(signers.size());
+    std::vector<Data> transactions(signers.size());
+    parallelFor(signers.size(), threads, batchChunkSize, [&](std::size_t begin, std::size_t end) {
+        signRange(signers, begin, end, signatures);
+        for (auto i = begin; i < end; i += 1) {
+            const auto& signer = signers[i];
+            if (!publicKeys[i] || signatures[i].empty()) {
+                continue;
+            }
+            transactions[i] = Amino::encodeTransaction(signer, signatures[i], *publicKeys[i]);
         }
-        cos.WriteRaw(typePrefix.data(), typePrefix.size());
-        cos.WriteRaw(raw.data(), raw.size());
+    });
+    return transactions;
+}
+
+template <typename Order>
+Data TypedSigner<Order>::build() const {
+    auto signature = sign();
+    if (signature.empty()) {
+        return {};
     }
 
-    return Data(msg.begin(), msg.end());
+    const auto publicKey = aminoPublicKey();
+    if (publicKey.empty()) {
+        return {};
+    }
+    return Amino::encodeTransaction(*this, order, signature, publicKey);
+}
+
+template <typename Order>
+Data TypedSigner<Order>::sign() const {
+    return sign(nullptr);
 }
+
+template <typename Order>
+Data TypedSigner<Order>::sign(std::string& preimage) const {
+    preimage.clear();
+    return sign(&preimage);
+}
+
+template <typename Order>
+Data TypedSigner<Order>::sign(std::string* preimage) const {
+    auto sink = SHA256Sink(preimage);
+    writeSignaturePreimage(*this, order, sink);
+
+    byte hash[SHA256_DIGEST_LENGTH];
+    sink.finish(hash);
+    return signDigest(hash);
+}
+
+template class Binance::TypedSigner<NewOrder>;
+template class Binance::TypedSigner<CancelOrder>;
+template class Binance::TypedSigner<Send>;
+template class Binance::TypedSigner<TokenFreeze>;
+template class Binance::TypedSigner<TokenUnfreeze>;
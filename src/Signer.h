@@ -9,15 +9,18 @@
 
 #include "dex.pb.h"
 #include "Data.h"
+#include "SigningKey.h"
+#include "Sink.h"
 
+#include <memory>
 #include <stdint.h>
 #include <string>
 #include <vector>
 
 namespace Binance {
 
-/// Helper class that performs BNB transaction signing.
-class Signer {
+/// Transaction fields and signing key shared by all signers.
+class SignerBase {
 public:
     /// Chain identifier.
     std::string chainId;
@@ -37,13 +40,39 @@ public:
     std::string memo;
 
     /// Private signing key.
+    ///
+    /// Ignored when `signingKey` is set.
     Data privateKey;
 
+    /// Signing key with its derived public data, preferred over `privateKey`.
+    std::shared_ptr<const SigningKey> signingKey;
+
+protected:
+    SignerBase(std::shared_ptr<const SigningKey> signingKey) : chainId("chain-bnb"), accountNumber(), sequence(), source(), memo(), privateKey(), signingKey(std::move(signingKey)) {}
+
+    /// Signs the hash of the sign bytes.
+    ///
+    /// \returns the signature or an empty vector if there is an error.
+    Data signDigest(const byte digest[SHA256_DIGEST_LENGTH]) const;
+
+    /// Returns the amino-encoded public key, deriving only the public key from `privateKey` if `signingKey` is
+    /// not set.
+    ///
+    /// \returns the encoded public key, or an empty vector if `privateKey` is invalid.
+    Data aminoPublicKey() const;
+};
+
+/// Helper class that performs BNB transaction signing.
+class Signer : public SignerBase {
+public:
     /// Order to sign.
     const ::google::protobuf::Message& order;
 
     /// Initializes a transaction signer.
-    Signer(const ::google::protobuf::Message& order) : chainId("chain-bnb"), accountNumber(), sequence(), source(), memo(), privateKey(), order(order) {}
+    Signer(const ::google::protobuf::Message& order) : SignerBase(nullptr), order(order) {}
+
+    /// Initializes a transaction signer with a shared signing key.
+    Signer(const ::google::protobuf::Message& order, std::shared_ptr<const SigningKey> signingKey) : SignerBase(std::move(signingKey)), order(order) {}
 
     /// Builds a signed transaction.
     ///
@@ -52,14 +81,85 @@ public:
 
     /// Signs the transaction.
     ///
+    /// Sign bytes are hashed as they are generated and never stored.
+    ///
     /// \returns the transaction signature or an empty vector if there is an error.
     Data sign() const;
 
+    /// Signs the transaction and, for debugging, also stores its sign bytes in `preimage`.
+    ///
+    /// \returns the transaction signature or an empty vector if there is an error.
+    Data sign(std::string& preimage) const;
+
+    /// Signs a batch of transactions.
+    ///
+    /// The work is spread over `threads` workers; `0` uses one worker per hardware thread. Each worker
+    /// signs its transactions in groups that share the modular inversions of their nonces. No public
+    /// keys are derived.
+    ///
+    /// \returns one signature per signer in input order; an entry is empty if that signer failed.
+    static std::vector<Data> signBatch(const std::vector<Signer>& signers, unsigned threads = 0);
+
+    /// Builds a batch of signed transactions.
+    ///
+    /// Signs like `signBatch`. Signers without a `signingKey` that share a private key derive its public
+    /// key once for the whole batch.
+    ///
+    /// \see signBatch
+    /// \returns one signed transaction per signer in input order; an entry is empty if that signer failed.
+    static std::vector<Data> buildBatch(const std::vector<Signer>& signers, unsigned threads = 0);
+
 private:
-    Data encodeTransaction(const Data& signature) const;
-    Data encodeOrder() const;
-    Data encodeSignature(const Data& signature) const;
-    Data aminoWrap(const std::string& raw, const Data& typePrefix, bool isPrefixLength) const;
+    /// Hashes the sign bytes, also appending them to `preimage` unless it is null.
+    void signatureDigest(byte digest[SHA256_DIGEST_LENGTH], std::string* preimage = nullptr) const;
+
+    /// Signs `signers[begin..<end]` with shared modular inversions, storing each signature at the signer's index.
+    static void signRange(const std::vector<Signer>& signers, std::size_t begin, std::size_t end, std::vector<Data>& signatures);
 };
 
+/// Transaction signer specialized for one order type.
+///
+/// The amino prefix and the sign-bytes layout are resolved at compile time instead of by inspecting
+/// the message type, and the order is only accessed by reference. `Order` must be one of `NewOrder`,
+/// `CancelOrder`, `Send`, `TokenFreeze` or `TokenUnfreeze`; use `Signer` for messages of unknown type.
+template <typename Order>
+class TypedSigner : public SignerBase {
+public:
+    /// Order to sign.
+    const Order& order;
+
+    /// Initializes a transaction signer.
+    TypedSigner(const Order& order) : SignerBase(nullptr), order(order) {}
+
+    /// Initializes a transaction signer with a shared signing key.
+    TypedSigner(const Order& order, std::shared_ptr<const SigningKey> signingKey) : SignerBase(std::move(signingKey)), order(order) {}
+
+    /// Builds a signed transaction.
+    ///
+    /// \returns the signed transaction data or an empty vector if there is an error.
+    Data build() const;
+
+    /// Signs the transaction.
+    ///
+    /// Sign bytes are hashed as they are generated and never stored.
+    ///
+    /// \returns the transaction signature or an empty vector if there is an error.
+    Data sign() const;
+
+    /// Signs the transaction and, for debugging, also stores its sign bytes in `preimage`.
+    ///
+    /// \returns the transaction signature or an empty vector if there is an error.
+    Data sign(std::string& preimage) const;
+
+private:
+    /// Signs the transaction, also appending the sign bytes to `preimage` unless it is null.
+    Data sign(std::string* preimage) const;
+};
+
+extern template class TypedSigner<NewOrder>;
+extern template class TypedSigner<CancelOrder>;
+extern template class TypedSigner<Send>;
+extern template class TypedSigner<TokenFreeze>;
+extern template class TypedSigner<TokenUnfreeze>;
+
 } // namespace
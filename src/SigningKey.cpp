@@ -0,0 +1,65 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "SigningKey.h"
+
+#include "Amino.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/memzero.h"
+#include "crypto/secp256k1.h"
+
+#include <stdexcept>
+
+using namespace Binance;
+
+static const Data& validated(const Data& privateKey) {
+    if (privateKey.size() != 32) {
+        throw std::invalid_argument("Invalid private key size");
+    }
+    if (!SigningKey::isValid(privateKey)) {
+        throw std::invalid_argument("Invalid private key");
+    }
+    return privateKey;
+}
+
+static Data derivePublicKey(const Data& privateKey) {
+    Data publicKey(33);
+    ecdsa_get_public_key33(&secp256k1, privateKey.data(), publicKey.data());
+    return publicKey;
+}
+
+static Data publicKeyHash(const Data& publicKey) {
+    Data keyHash(20);
+    ecdsa_get_pubkeyhash(publicKey.data(), HASHER_SHA2_RIPEMD, keyHash.data());
+    return keyHash;
+}
+
+static rfc6979_key prepareNonceKey(const Data& privateKey) {
+    rfc6979_key key;
+    init_rfc6979_key(privateKey.data(), &key);
+    return key;
+}
+
+bool SigningKey::isValid(const Data& privateKey) {
+    if (privateKey.size() != 32) {
+        return false;
+    }
+    bignum256 k;
+    bn_read_be(privateKey.data(), &k);
+    const auto valid = !bn_is_zero(&k) && bn_is_less(&k, &secp256k1.order);
+    memzero(&k, sizeof(k));
+    return valid;
+}
+
+SigningKey::SigningKey(const Data& privateKey, const std::string& hrp)
+    : privateKey(validated(privateKey))
+    , publicKey(derivePublicKey(privateKey))
+    , aminoPublicKey(Amino::encodePublicKey(publicKey))
+    , keyHash(publicKeyHash(publicKey))
+    , address(Address(hrp, keyHash).encode())
+    , nonceKey(prepareNonceKey(privateKey)) {}
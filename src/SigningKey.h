@@ -0,0 +1,52 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "Data.h"
+
+#include "crypto/rfc6979.h"
+
+#include <string>
+
+namespace Binance {
+
+/// Private signing key together with the public data derived from it.
+///
+/// Deriving the public key is a full scalar multiplication, so a key that signs many transactions
+/// should be built once and shared between signers.
+class SigningKey {
+public:
+    /// Private key, 32 bytes.
+    const Data privateKey;
+
+    /// Compressed public key, 33 bytes.
+    const Data publicKey;
+
+    /// Amino-encoded public key, as embedded in transaction signatures.
+    const Data aminoPublicKey;
+
+    /// Public key hash, 20 bytes.
+    const Data keyHash;
+
+    /// Bech32 address of the key hash.
+    const std::string address;
+
+    /// Per-key part of the RFC6979 nonce derivation, so that signing with this key skips it.
+    const rfc6979_key nonceKey;
+
+    /// Determines whether a byte string is a valid secp256k1 private key.
+    static bool isValid(const Data& privateKey);
+
+    /// Initializes a signing key and derives its public data.
+    ///
+    /// \throws std::invalid_argument if the private key is not a valid secp256k1 private key.
+    explicit SigningKey(const Data& privateKey, const std::string& hrp = Address::binanceHRP);
+};
+
+} // namespace
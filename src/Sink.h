@@ -0,0 +1,67 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "crypto/sha2.h"
+
+#include <cstddef>
+#include <string>
+
+namespace Binance {
+
+/// Destination for streamed bytes.
+class Sink {
+public:
+    virtual ~Sink() = default;
+
+    /// Consumes the next chunk of bytes.
+    virtual void write(const char* data, std::size_t size) = 0;
+};
+
+/// Sink that appends to a string.
+class StringSink : public Sink {
+public:
+    explicit StringSink(std::string& out) : out(out) {}
+
+    void write(const char* data, std::size_t size) override {
+        out.append(data, size);
+    }
+
+private:
+    std::string& out;
+};
+
+/// Sink that hashes its input with SHA-256 without storing it.
+class SHA256Sink : public Sink {
+public:
+    /// Initializes a hashing sink.
+    ///
+    /// \param capture if not null, also receives a copy of every byte, for debugging.
+    explicit SHA256Sink(std::string* capture = nullptr) : capture(capture) {
+        sha256_Init(&context);
+    }
+
+    void write(const char* data, std::size_t size) override {
+        sha256_Update(&context, reinterpret_cast<const byte*>(data), size);
+        if (capture != nullptr) {
+            capture->append(data, size);
+        }
+    }
+
+    /// Writes the digest of everything consumed so far; the sink must not be written to afterwards.
+    void finish(byte hash[SHA256_DIGEST_LENGTH]) {
+        sha256_Final(&context, hash);
+    }
+
+private:
+    SHA256_CTX context;
+    std::string* capture;
+};
+
+} // namespace
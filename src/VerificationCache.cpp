@@ -0,0 +1,75 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "VerificationCache.h"
+#include "HashMix.h"
+
+#include "crypto/secp256k1.h"
+
+#include <algorithm>
+
+using namespace Binance;
+
+std::size_t VerificationCache::KeyHash::operator()(const PublicKey& key) const {
+    return static_cast<std::size_t>(hashBytes<std::tuple_size<PublicKey>::value>(key.data()));
+}
+
+bool VerificationCache::verify(const Data& publicKey, const Data& signature, const Data& digest) {
+    // only compressed keys fit the 33-byte key; a 0x04 prefix would make the key reader take 65 bytes
+    if (publicKey.size() != 33 || (publicKey[0] != 0x02 && publicKey[0] != 0x03) || signature.size() != 64 || digest.size() != 32) {
+        return false;
+    }
+    PublicKey key;
+    std::copy(publicKey.begin(), publicKey.end(), key.begin());
+
+    auto table = find(key);
+    if (table) {
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+        auto prepared = std::make_shared<ecdsa_pubkey_table>();
+        if (!ecdsa_pubkey_table_init(&secp256k1, key.data(), prepared.get())) {
+            return false;
+        }
+        table = insert(key, std::move(prepared));
+    }
+    return ecdsa_verify_digest_table(&secp256k1, table.get(), signature.data(), digest.data()) == 0;
+}
+
+std::size_t VerificationCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+VerificationCache::Table VerificationCache::find(const PublicKey& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = index.find(key);
+    if (found == index.end()) {
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->second;
+}
+
+VerificationCache::Table VerificationCache::insert(const PublicKey& key, Table table) {
+    if (maxSize == 0) {
+        return table;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->second;
+    }
+    if (entries.size() == maxSize) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(key, table);
+    index.emplace(key, entries.begin());
+    return table;
+}
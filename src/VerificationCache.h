@@ -0,0 +1,89 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include "crypto/ecdsa.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Binance {
+
+/// Verifies secp256k1 signatures and keeps the prepared form of recently used public keys.
+///
+/// For every cached key the cache holds the decoded point and a table of its odd multiples wider than
+/// the one `ecdsa_verify_digest` builds per call. Verifications against a cached key therefore skip the
+/// decompression square root and the table construction. At most `capacity` keys are kept; the least
+/// recently used one is evicted first. All members may be called from several threads at once.
+class VerificationCache {
+public:
+    /// Compressed public key, 33 bytes.
+    using PublicKey = std::array<byte, 33>;
+
+    /// Initializes an empty cache for up to `capacity` keys; `0` disables caching.
+    explicit VerificationCache(std::size_t capacity = 4096) : maxSize(capacity) {}
+
+    VerificationCache(const VerificationCache&) = delete;
+    VerificationCache& operator=(const VerificationCache&) = delete;
+
+    /// Determines whether `signature` (64 bytes, r followed by s) signs the 32-byte `digest` with the key
+    /// of the compressed `publicKey`.
+    ///
+    /// Returns `false` for malformed input, including public keys that are not compressed or not on the curve.
+    bool verify(const Data& publicKey, const Data& signature, const Data& digest);
+
+    /// Number of verifications that found their key in the cache.
+    std::uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+
+    /// Number of verifications that had to prepare their key.
+    std::uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+    /// Number of keys currently cached.
+    std::size_t size() const;
+
+    /// Maximum number of keys cached.
+    std::size_t capacity() const { return maxSize; }
+
+private:
+    using Table = std::shared_ptr<const ecdsa_pubkey_table>;
+    using Entries = std::list<std::pair<PublicKey, Table>>;
+
+    /// Hashes a key with the keyed `hashBytes`, since callers may pass any x coordinate on the curve and must not
+    /// be able to fill one bucket of the index.
+    struct KeyHash {
+        std::size_t operator()(const PublicKey& key) const;
+    };
+
+    /// Returns the table of a cached key, marking it as most recently used, or `nullptr`.
+    Table find(const PublicKey& key);
+
+    /// Caches a prepared key and returns the table to use, which is the cached one if another thread
+    /// inserted the key first.
+    Table insert(const PublicKey& key, Table table);
+
+    const std::size_t maxSize;
+    mutable std::mutex mutex;
+
+    /// Cached keys from the most to the least recently used one.
+    Entries entries;
+    std::unordered_map<PublicKey, Entries::iterator, KeyHash> index;
+
+    std::atomic<std::uint64_t> hitCount{0};
+    std::atomic<std::uint64_t> missCount{0};
+};
+
+} // namespace
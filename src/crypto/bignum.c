@@ -29,6 +29,8 @@
 
 #include "bignum.h"
 #include "memzero.h"
+#include "modinv64.h"
+#include "secp256k1_field.h"
 
 /* big number library */
 
@@ -517,6 +519,14 @@ void bn_fast_mod(bignum256 *x, const bignum256 *prime)
 	}
 }
 
+// returns 1 if prime is the secp256k1 field prime, 0 otherwise
+static int bn_is_secp256k1_prime(const bignum256 *prime)
+{
+	secp256k1_fe p;
+	secp256k1_fe_set_bn(&p, prime);
+	return p.n[0] == SECP256K1_FE_P0 && (p.n[1] & p.n[2] & p.n[3]) == 0xFFFFFFFFFFFFFFFFULL && prime->val[8] == 0xFFFF;
+}
+
 // square root of x = x^((p+1)/4)
 // http://en.wikipedia.org/wiki/Quadratic_residue#Prime_or_prime_power_modulus
 // assumes    x is normalized but not necessarily reduced.
@@ -526,6 +536,19 @@ void bn_sqrt(bignum256 *x, const bignum256 *prime)
 	// this method compute x^1/2 = x^(prime+1)/4
 	uint32_t i, j, limb;
 	bignum256 res, p;
+
+	if (bn_is_secp256k1_prime(prime)) {
+		// with the addition chain for this exponent
+		secp256k1_fe fx;
+		bn_fast_mod(x, prime);
+		bn_mod(x, prime);
+		secp256k1_fe_set_bn(&fx, x);
+		secp256k1_fe_sqrt(&fx, &fx);
+		secp256k1_fe_get_bn(x, &fx);
+		memzero(&fx, sizeof(fx));
+		return;
+	}
+
 	bn_one(&res);
 	// compute p = (prime+1)/4
 	memcpy(&p, prime, sizeof(bignum256));
@@ -557,37 +580,51 @@ void bn_sqrt(bignum256 *x, const bignum256 *prime)
 	memzero(&p, sizeof(p));
 }
 
-// in field G_prime, small but slow
+// r = a as four little-endian 64-bit limbs, for a normalized a
+static void bn_write_u64(const bignum256 *a, uint64_t r[4])
+{
+	const uint32_t *v = a->val;
+	r[0] = (uint64_t)v[0] | (uint64_t)v[1] << 30 | (uint64_t)v[2] << 60;
+	r[1] = (uint64_t)v[2] >> 4 | (uint64_t)v[3] << 26 | (uint64_t)v[4] << 56;
+	r[2] = (uint64_t)v[4] >> 8 | (uint64_t)v[5] << 22 | (uint64_t)v[6] << 52;
+	r[3] = (uint64_t)v[6] >> 12 | (uint64_t)v[7] << 18 | (uint64_t)v[8] << 48;
+}
+
+// r = a from four little-endian 64-bit limbs
+static void bn_read_u64(const uint64_t a[4], bignum256 *r)
+{
+	r->val[0] = a[0] & 0x3FFFFFFF;
+	r->val[1] = (a[0] >> 30) & 0x3FFFFFFF;
+	r->val[2] = (a[0] >> 60 | a[1] << 4) & 0x3FFFFFFF;
+	r->val[3] = (a[1] >> 26) & 0x3FFFFFFF;
+	r->val[4] = (a[1] >> 56 | a[2] << 8) & 0x3FFFFFFF;
+	r->val[5] = (a[2] >> 22) & 0x3FFFFFFF;
+	r->val[6] = (a[2] >> 52 | a[3] << 12) & 0x3FFFFFFF;
+	r->val[7] = (a[3] >> 18) & 0x3FFFFFFF;
+	r->val[8] = a[3] >> 48;
+}
+
+// x = x^-1 mod prime with the constant-time safegcd algorithm, 0 for x = 0
+// prime must be odd; the result is normalized
 void bn_inverse(bignum256 *x, const bignum256 *prime)
 {
-	// this method compute x^-1 = x^(prime-2)
-	uint32_t i, j, limb;
-	bignum256 res;
-	bn_one(&res);
-	for (i = 0; i < 9; i++) {
-		// invariants:
-		//    x   = old(x)^(2^(i*30))
-		//    res = old(x)^((prime-2) % 2^(i*30))
-		// get the i-th limb of prime - 2
-		limb = prime->val[i];
-		// this is not enough in general but fine for secp256k1 & nist256p1 because prime->val[0] > 1
-		if (i == 0) limb -= 2;
-		for (j = 0; j < 30; j++) {
-			// invariants:
-			//    x    = old(x)^(2^(i*30+j))
-			//    res  = old(x)^((prime-2) % 2^(i*30+j))
-			//    limb = ((prime-2) % 2^(i*30+30)) / 2^(i*30+j)
-			// early abort when only zero bits follow
-			if (i == 8 && limb == 0) break;
-			if (limb & 1) {
-				bn_multiply(x, &res, prime);
-			}
-			limb >>= 1;
-			bn_multiply(x, x, prime);
-		}
-	}
-	bn_mod(&res, prime);
-	memcpy(x, &res, sizeof(bignum256));
+	uint64_t limbs[4];
+	modinv64_modinfo modinfo;
+	modinv64_signed62 s;
+
+	assert((prime->val[0] & 1) == 1);
+	bn_write_u64(prime, limbs);
+	modinv64_modinfo_init(&modinfo, limbs);
+
+	bn_fast_mod(x, prime);
+	bn_mod(x, prime);
+	bn_write_u64(x, limbs);
+	modinv64_from_u64(&s, limbs);
+	modinv64(&s, &modinfo);
+	modinv64_to_u64(limbs, &s);
+	bn_read_u64(limbs, x);
+	memzero(limbs, sizeof(limbs));
+	memzero(&s, sizeof(s));
 }
 
 void bn_normalize(bignum256 *a) {
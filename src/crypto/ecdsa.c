@@ -33,6 +33,9 @@
 #include "hmac.h"
 #include "ecdsa.h"
 #include "secp256k1.h"
+#include "secp256k1_field.h"
+#include "secp256k1_field_x4.h"
+#include "secp256k1_scalar.h"
 #include "rfc6979.h"
 #include "memzero.h"
 
@@ -186,10 +189,17 @@ void conditional_negate(uint32_t cond, bignum256 *a, const bignum256 *prime)
 	assert(a->val[8] < 0x20000);
 }
 
+// Jacobian coordinates use the dedicated secp256k1 field arithmetic, which
+// covers the only curve (a = 0) this library works with.
 typedef struct jacobian_curve_point {
-	bignum256 x, y, z;
+	secp256k1_fe x, y, z;
 } jacobian_curve_point;
 
+static void curve_to_fe(const curve_point *p, fe_curve_point *fp) {
+	secp256k1_fe_set_bn(&fp->x, &p->x);
+	secp256k1_fe_set_bn(&fp->y, &p->y);
+}
+
 // generate random K for signing/side-channel noise
 static void generate_k_random(bignum256 *k, const bignum256 *prime) {
 	do {
@@ -202,47 +212,58 @@ static void generate_k_random(bignum256 *k, const bignum256 *prime) {
 	} while (bn_is_zero(k) || !bn_is_less(k, prime));
 }
 
-void curve_to_jacobian(const curve_point *p, jacobian_curve_point *jp, const bignum256 *prime) {
+void curve_to_jacobian(const fe_curve_point *p, jacobian_curve_point *jp, const bignum256 *prime) {
+	bignum256 z;
+	secp256k1_fe zpow;
+
 	// randomize z coordinate
-	generate_k_random(&jp->z, prime);
-
-	jp->x = jp->z;
-	bn_multiply(&jp->z, &jp->x, prime);
-	// x = z^2
-	jp->y = jp->x;
-	bn_multiply(&jp->z, &jp->y, prime);
-	// y = z^3
-
-	bn_multiply(&p->x, &jp->x, prime);
-	bn_multiply(&p->y, &jp->y, prime);
-}
-
-void jacobian_to_curve(const jacobian_curve_point *jp, curve_point *p, const bignum256 *prime) {
-	p->y = jp->z;
-	bn_inverse(&p->y, prime);
-	// p->y = z^-1
-	p->x = p->y;
-	bn_multiply(&p->x, &p->x, prime);
-	// p->x = z^-2
-	bn_multiply(&p->x, &p->y, prime);
-	// p->y = z^-3
-	bn_multiply(&jp->x, &p->x, prime);
-	// p->x = jp->x * z^-2
-	bn_multiply(&jp->y, &p->y, prime);
-	// p->y = jp->y * z^-3
-	bn_mod(&p->x, prime);
-	bn_mod(&p->y, prime);
-}
-
-void point_jacobian_add(const curve_point *p1, jacobian_curve_point *p2, const ecdsa_curve *curve) {
-	bignum256 r, h, r2;
-	bignum256 hcby, hsqx;
-	bignum256 xz, yz, az;
+	generate_k_random(&z, prime);
+	secp256k1_fe_set_bn(&jp->z, &z);
+
+	secp256k1_fe_sqr(&zpow, &jp->z);
+	// zpow = z^2
+	secp256k1_fe_mul(&jp->x, &p->x, &zpow);
+	secp256k1_fe_mul(&zpow, &zpow, &jp->z);
+	// zpow = z^3
+	secp256k1_fe_mul(&jp->y, &p->y, &zpow);
+	memzero(&z, sizeof(z));
+}
+
+// p = jp in affine coordinates, given zinv = jp->z^-1
+static void jacobian_to_fe_zinv(const jacobian_curve_point *jp, const secp256k1_fe *zinv, fe_curve_point *p) {
+	secp256k1_fe zpow;
+
+	secp256k1_fe_sqr(&zpow, zinv);
+	// zpow = z^-2
+	secp256k1_fe_mul(&p->x, &jp->x, &zpow);
+	secp256k1_fe_mul(&zpow, &zpow, zinv);
+	// zpow = z^-3
+	secp256k1_fe_mul(&p->y, &jp->y, &zpow);
+}
+
+static void jacobian_to_curve_zinv(const jacobian_curve_point *jp, const secp256k1_fe *zinv, curve_point *p) {
+	fe_curve_point fp;
+
+	jacobian_to_fe_zinv(jp, zinv, &fp);
+	secp256k1_fe_get_bn(&p->x, &fp.x);
+	secp256k1_fe_get_bn(&p->y, &fp.y);
+}
+
+void jacobian_to_curve(const jacobian_curve_point *jp, curve_point *p) {
+	secp256k1_fe zinv;
+	secp256k1_fe_inv(&zinv, &jp->z);
+	jacobian_to_curve_zinv(jp, &zinv, p);
+	memzero(&zinv, sizeof(zinv));
+}
+
+void point_jacobian_add(const fe_curve_point *p1, jacobian_curve_point *p2, const ecdsa_curve *curve) {
+	secp256k1_fe r, h, r2;
+	secp256k1_fe hcby, hsqx;
+	secp256k1_fe xz, yz;
 	int is_doubling;
-	const bignum256 *prime = &curve->prime;
-	int a = curve->a;
 
-	assert (-3 <= a && a <= 0);
+	assert (curve->a == 0);
+	(void)curve;
 
 	/* First we bring p1 to the same denominator:
 	 * x1' := x1 * z2^2
@@ -255,13 +276,13 @@ void point_jacobian_add(const curve_point *p1, jacobian_curve_point *p2, const e
 	 * y3/z3^3 = 1/2 lambda * (2x3/z3^2 - (x1' + x2)/z2^2) + (y1'+y2)/z2^3
 	 *
 	 * For the special case x1=x2, y1=y2 (doubling) we have
-	 * lambda = 3/2 ((x2/z2^2)^2 + a) / (y2/z2^3)
-	 *        = 3/2 (x2^2 + a*z2^4) / y2*z2)
+	 * lambda = 3/2 (x2/z2^2)^2 / (y2/z2^3)
+	 *        = 3/2 x2^2 / (y2*z2)
 	 *
 	 * to get rid of fraction we write lambda as
 	 * lambda = r / (h*z2)
-	 * with  r = is_doubling ? 3/2 x2^2 + az2^4 : (y1 - y2)
-	 *       h = is_doubling ?      y1+y2       : (x1 - x2)
+	 * with  r = is_doubling ? 3 x2^2 : (y1 - y2)
+	 *       h = is_doubling ?  y1+y2 : (x1 - x2)
 	 *
 	 * With z3 = h*z2  (the denominator of lambda)
 	 * we get x3 = lambda^2*z3^2 - (x1' + x2)/z2^2*z3^2
@@ -269,103 +290,71 @@ void point_jacobian_add(const curve_point *p1, jacobian_curve_point *p2, const e
 	 *    and y3 = 1/2 r * (2x3 - h^2*(x1' + x2)) + h^3*(y1' + y2)
 	 */
 
-	/* h = x1 - x2
-	 * r = y1 - y2
-	 * x3 = r^2 - h^3 - 2*h^2*x2
-	 * y3 = r*(h^2*x2 - x3) - h^3*y2
-	 * z3 = h*z2
-	 */
+	secp256k1_fe_sqr(&xz, &p2->z);          // xz = z2^2
+	secp256k1_fe_mul(&yz, &xz, &p2->z);     // yz = z2^3
 
-	xz = p2->z;
-	bn_multiply(&xz, &xz, prime); // xz = z2^2
-	yz = p2->z;
-	bn_multiply(&xz, &yz, prime); // yz = z2^3
-	
-	if (a != 0) {
-		az  = xz;
-		bn_multiply(&az, &az, prime);   // az = z2^4
-		bn_mult_k(&az, -a, prime);      // az = -az2^4
-	}
-	
-	bn_multiply(&p1->x, &xz, prime);        // xz = x1' = x1*z2^2;
-	h = xz;
-	bn_subtractmod(&h, &p2->x, &h, prime);
-	bn_fast_mod(&h, prime);
+	secp256k1_fe_mul(&xz, &xz, &p1->x);     // xz = x1' = x1*z2^2;
+	secp256k1_fe_sub(&h, &xz, &p2->x);
 	// h = x1' - x2;
 
-	bn_add(&xz, &p2->x);
+	secp256k1_fe_add(&xz, &xz, &p2->x);
 	// xz = x1' + x2
 
-	// check for h == 0 % prime.  Note that h never normalizes to
-	// zero, since h = x1' + 2*prime - x2 > 0 and a positive
-	// multiple of prime is always normalized to prime by
-	// bn_fast_mod.
-	is_doubling = bn_is_equal(&h, prime);
+	is_doubling = secp256k1_fe_is_zero(&h);
 
-	bn_multiply(&p1->y, &yz, prime);        // yz = y1' = y1*z2^3;
-	bn_subtractmod(&yz, &p2->y, &r, prime);
+	secp256k1_fe_mul(&yz, &yz, &p1->y);     // yz = y1' = y1*z2^3;
+	secp256k1_fe_sub(&r, &yz, &p2->y);
 	// r = y1' - y2;
 
-	bn_add(&yz, &p2->y);
+	secp256k1_fe_add(&yz, &yz, &p2->y);
 	// yz = y1' + y2
 
-	r2 = p2->x;
-	bn_multiply(&r2, &r2, prime);
-	bn_mult_k(&r2, 3, prime);
-	
-	if (a != 0) {
-		// subtract -a z2^4, i.e, add a z2^4
-		bn_subtractmod(&r2, &az, &r2, prime);
-	}
-	bn_cmov(&r, is_doubling, &r2, &r);
-	bn_cmov(&h, is_doubling, &yz, &h);
-	
+	secp256k1_fe_sqr(&r2, &p2->x);
+	secp256k1_fe_mul_int(&r2, &r2, 3);
+
+	secp256k1_fe_cmov(&r, &r2, is_doubling);
+	secp256k1_fe_cmov(&h, &yz, is_doubling);
 
 	// hsqx = h^2
-	hsqx = h;
-	bn_multiply(&hsqx, &hsqx, prime);
+	secp256k1_fe_sqr(&hsqx, &h);
 
 	// hcby = h^3
-	hcby = h;
-	bn_multiply(&hsqx, &hcby, prime);
+	secp256k1_fe_mul(&hcby, &hsqx, &h);
 
 	// hsqx = h^2 * (x1 + x2)
-	bn_multiply(&xz, &hsqx, prime);
+	secp256k1_fe_mul(&hsqx, &hsqx, &xz);
 
 	// hcby = h^3 * (y1 + y2)
-	bn_multiply(&yz, &hcby, prime);
+	secp256k1_fe_mul(&hcby, &hcby, &yz);
 
 	// z3 = h*z2
-	bn_multiply(&h, &p2->z, prime);
+	secp256k1_fe_mul(&p2->z, &p2->z, &h);
 
 	// x3 = r^2 - h^2 (x1 + x2)
-	p2->x = r;
-	bn_multiply(&p2->x, &p2->x, prime);
-	bn_subtractmod(&p2->x, &hsqx, &p2->x, prime);
-	bn_fast_mod(&p2->x, prime);
+	secp256k1_fe_sqr(&p2->x, &r);
+	secp256k1_fe_sub(&p2->x, &p2->x, &hsqx);
 
 	// y3 = 1/2 (r*(h^2 (x1 + x2) - 2x3) - h^3 (y1 + y2))
-	bn_subtractmod(&hsqx, &p2->x, &p2->y, prime);
-	bn_subtractmod(&p2->y, &p2->x, &p2->y, prime);
-	bn_multiply(&r, &p2->y, prime);
-	bn_subtractmod(&p2->y, &hcby, &p2->y, prime);
-	bn_mult_half(&p2->y, prime);
-	bn_fast_mod(&p2->y, prime);
+	secp256k1_fe_sub(&p2->y, &hsqx, &p2->x);
+	secp256k1_fe_sub(&p2->y, &p2->y, &p2->x);
+	secp256k1_fe_mul(&p2->y, &p2->y, &r);
+	secp256k1_fe_sub(&p2->y, &p2->y, &hcby);
+	secp256k1_fe_half(&p2->y, &p2->y);
 }
 
 void point_jacobian_double(jacobian_curve_point *p, const ecdsa_curve *curve) {
-	bignum256 az4, m, msq, ysq, xysq;
-	const bignum256 *prime = &curve->prime;
+	secp256k1_fe m, msq, ysq, xysq;
 
-	assert (-3 <= curve->a && curve->a <= 0);
+	assert (curve->a == 0);
+	(void)curve;
 	/* usual algorithm:
 	 *
-	 * lambda  = (3((x/z^2)^2 + a) / 2y/z^3) = (3x^2 + az^4)/2yz
+	 * lambda  = (3(x/z^2)^2 / 2y/z^3) = 3x^2/2yz
 	 * x3/z3^2 = lambda^2 - 2x/z^2
 	 * y3/z3^3 = lambda * (x/z^2 - x3/z3^2) - y/z^3
 	 *
 	 * to get rid of fraction we set
-	 *  m = (3 x^2 + az^4) / 2
+	 *  m = 3 x^2 / 2
 	 * Hence,
 	 *  lambda = m / yz = m / z3
 	 *
@@ -376,49 +365,95 @@ void point_jacobian_double(jacobian_curve_point *p, const ecdsa_curve *curve) {
 	 *           = m * (xy^2 - x3) - y^4
 	 */
 
-	/* m = (3*x^2 + a z^4) / 2
+	/* m = 3*x^2 / 2
 	 * x3 = m^2 - 2*xy^2
-	 * y3 = m*(xy^2 - x3) - 8y^4
+	 * y3 = m*(xy^2 - x3) - y^4
 	 * z3 = y*z
 	 */
 
-	m = p->x;
-	bn_multiply(&m, &m, prime);
-	bn_mult_k(&m, 3, prime);
-
-	az4 = p->z;
-	bn_multiply(&az4, &az4, prime);
-	bn_multiply(&az4, &az4, prime);
-	bn_mult_k(&az4, -curve->a, prime);
-	bn_subtractmod(&m, &az4, &m, prime);
-	bn_mult_half(&m, prime);
+	secp256k1_fe_sqr(&m, &p->x);
+	secp256k1_fe_mul_int(&m, &m, 3);
+	secp256k1_fe_half(&m, &m);
 
 	// msq = m^2
-	msq = m;
-	bn_multiply(&msq, &msq, prime);
+	secp256k1_fe_sqr(&msq, &m);
 	// ysq = y^2
-	ysq = p->y;
-	bn_multiply(&ysq, &ysq, prime);
+	secp256k1_fe_sqr(&ysq, &p->y);
 	// xysq = xy^2
-	xysq = p->x;
-	bn_multiply(&ysq, &xysq, prime);
+	secp256k1_fe_mul(&xysq, &p->x, &ysq);
 
 	// z3 = yz
-	bn_multiply(&p->y, &p->z, prime);
+	secp256k1_fe_mul(&p->z, &p->z, &p->y);
 
 	// x3 = m^2 - 2*xy^2
-	p->x = xysq;
-	bn_lshift(&p->x);
-	bn_fast_mod(&p->x, prime);
-	bn_subtractmod(&msq, &p->x, &p->x, prime);
-	bn_fast_mod(&p->x, prime);
+	secp256k1_fe_add(&p->x, &xysq, &xysq);
+	secp256k1_fe_sub(&p->x, &msq, &p->x);
 
 	// y3 = m*(xy^2 - x3) - y^4
-	bn_subtractmod(&xysq, &p->x, &p->y, prime);
-	bn_multiply(&m, &p->y, prime);
-	bn_multiply(&ysq, &ysq, prime);
-	bn_subtractmod(&p->y, &ysq, &p->y, prime);
-	bn_fast_mod(&p->y, prime);
+	secp256k1_fe_sub(&p->y, &xysq, &p->x);
+	secp256k1_fe_mul(&p->y, &p->y, &m);
+	secp256k1_fe_sqr(&ysq, &ysq);
+	secp256k1_fe_sub(&p->y, &p->y, &ysq);
+}
+
+// pmult[t * count + i] = (2*i+1) * p[t] for n points and count >= 2 odd
+// multiples each. The odd multiples are summed up in Jacobian coordinates
+// and brought to affine coordinates with two batch inversions for all
+// points; jp, zinv and scratch hold n * count entries.
+static void point_multiply_table_batch(const ecdsa_curve *curve, const curve_point *p, size_t n, int count, fe_curve_point *pmult, jacobian_curve_point *jp, secp256k1_fe *zinv, secp256k1_fe *scratch)
+{
+	const secp256k1_fe one = {{1, 0, 0, 0}};
+	fe_curve_point p2;
+	size_t t;
+	int i;
+
+	assert (count >= 2);
+	for (t = 0; t < n; t++) {
+		jacobian_curve_point *jt = jp + t * count;
+		curve_to_fe(&p[t], &pmult[t * count]);
+		jt[0].x = pmult[t * count].x;
+		jt[0].y = pmult[t * count].y;
+		jt[0].z = one;
+		jt[1] = jt[0];
+		point_jacobian_double(&jt[1], curve);
+		zinv[t] = jt[1].z;
+	}
+	// 2*p[t] in affine coordinates, kept in pmult[t * count + 1] until the
+	// additions below no longer need it
+	secp256k1_fe_inv_batch(zinv, scratch, n);
+	for (t = 0; t < n; t++) {
+		jacobian_to_fe_zinv(&jp[t * count + 1], &zinv[t], &pmult[t * count + 1]);
+	}
+
+	// compute 3*p, etc by repeatedly adding p^2.
+	for (t = 0; t < n; t++) {
+		jacobian_curve_point *jt = jp + t * count;
+		p2 = pmult[t * count + 1];
+		for (i = 1; i < count; i++) {
+			jt[i] = jt[i - 1];
+			point_jacobian_add(&p2, &jt[i], curve);
+			zinv[t * (count - 1) + i - 1] = jt[i].z;
+		}
+	}
+	secp256k1_fe_inv_batch(zinv, scratch, n * (count - 1));
+	for (t = 0; t < n; t++) {
+		for (i = 1; i < count; i++) {
+			jacobian_to_fe_zinv(&jp[t * count + i], &zinv[t * (count - 1) + i - 1], &pmult[t * count + i]);
+		}
+	}
+	memzero(&p2, sizeof(p2));
+	memzero(jp, n * count * sizeof(jacobian_curve_point));
+	memzero(zinv, n * count * sizeof(secp256k1_fe));
+}
+
+// pmult[i] = (2*i+1) * p for count <= ECDSA_PUBKEY_TABLE_SIZE entries
+static void point_multiply_table(const ecdsa_curve *curve, const curve_point *p, fe_curve_point *pmult, int count)
+{
+	jacobian_curve_point jp[ECDSA_PUBKEY_TABLE_SIZE];
+	secp256k1_fe zinv[ECDSA_PUBKEY_TABLE_SIZE], scratch[ECDSA_PUBKEY_TABLE_SIZE];
+
+	assert (count >= 2 && count <= ECDSA_PUBKEY_TABLE_SIZE);
+	point_multiply_table_batch(curve, p, 1, count, pmult, jp, zinv, scratch);
 }
 
 // res = k * p
@@ -429,6 +464,7 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_po
 	//  Small Memory and Fast Elliptic Scalar Multiplications Secure against
 	//  Side Channel Attacks.
 	assert (bn_is_less(k, &curve->order));
+	assert (bn_is_equal(&curve->prime, &secp256k1.prime));
 
 	int i, j;
 	bignum256 a;
@@ -438,7 +474,7 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_po
 	uint32_t is_even = (k->val[0] & 1) - 1;
 	uint32_t bits, sign, nsign;
 	jacobian_curve_point jres;
-	curve_point pmult[8];
+	fe_curve_point pmult[8];
 	const bignum256 *prime = &curve->prime;
 
 	// is_even = 0xffffffff if k is even, 0 otherwise.
@@ -477,15 +513,7 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_po
 	// We compute |a[i]| * p in advance for all possible
 	// values of |a[i]| * p.  pmult[i] = (2*i+1) * p
 	// We compute p, 3*p, ..., 15*p and store it in the table pmult.
-	// store p^2 temporarily in pmult[7]
-	pmult[7] = *p;
-	point_double(curve, &pmult[7]);
-	// compute 3*p, etc by repeatedly adding p^2.
-	pmult[0] = *p;
-	for (i = 1; i < 8; i++) {
-		pmult[i] = pmult[7];
-		point_add(curve, &pmult[i-1], &pmult[i]);
-	}
+	point_multiply_table(curve, p, pmult, 8);
 
 	// now compute  res = sum_{i=0..63} a[i] * 16^i * p step by step,
 	// starting with i = 63.
@@ -531,34 +559,53 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_po
 
 		// negate last result to make signs of this round and the
 		// last round equal.
-		conditional_negate(sign ^ nsign, &jres.z, prime);
+		secp256k1_fe_cneg(&jres.z, sign ^ nsign);
 
 		// add odd factor
 		point_jacobian_add(&pmult[bits >> 1], &jres, curve);
 		sign = nsign;
 	}
-	conditional_negate(sign, &jres.z, prime);
-	jacobian_to_curve(&jres, res, prime);
+	secp256k1_fe_cneg(&jres.z, sign);
+	jacobian_to_curve(&jres, res);
 	memzero(&a, sizeof(a));
 	memzero(&jres, sizeof(jres));
+	memzero(pmult, sizeof(pmult));
 }
 
-// res = k * G
-// k must be a normalized number with 0 <= k < curve->order
-void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res)
+#if SECP256K1_COMB_WINDOW == 4
+// curve->cp
+#define DEFAULT_COMB NULL
+#else
+#define DEFAULT_COMB (&secp256k1_comb)
+#endif
+
+// p = (2*j+1) * 2^(window*i) * G from comb, or from curve->cp if comb is NULL
+static void comb_lookup(const ecdsa_curve *curve, const ecdsa_comb *comb, int i, uint32_t j, fe_curve_point *p)
 {
-	assert (bn_is_less(k, &curve->order));
+	if (comb) {
+		*p = comb->table[(i << (comb->window - 1)) + j];
+	} else {
+		curve_to_fe(&curve->cp[i][j], p);
+	}
+}
 
+// Recodes k into the signed window digits of the comb, see
+// scalar_multiply_jacobian: step i adds the table entry digit[i] of row i
+// after negating the sum with the mask flip[i], and flip[digits] negates
+// the final sum. Returns 0 if k is zero.
+// k must be a normalized number with 0 <= k < curve->order
+static int comb_recode(const ecdsa_curve *curve, int window, const bignum256 *k, uint32_t *digit, uint32_t *flip)
+{
 	int i, j;
 	bignum256 a;
 	uint32_t is_even = (k->val[0] & 1) - 1;
 	uint32_t lowbits;
-	jacobian_curve_point jres;
-	const bignum256 *prime = &curve->prime;
+	const int digits = ECDSA_COMB_DIGITS(window);
+	const uint32_t mask = (1 << window) - 1;
 
 	// is_even = 0xffffffff if k is even, 0 otherwise.
 
-	// add 2^256.
+	// add 2^(window*digits), which is 2^256 for windows dividing 256.
 	// make number odd: subtract curve->order if even
 	uint32_t tmp = 1;
 	uint32_t is_non_zero = 0;
@@ -569,66 +616,443 @@ void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *
 		tmp >>= 30;
 	}
 	is_non_zero |= k->val[j];
-	a.val[j] = tmp + 0xffff + k->val[j] - (curve->order.val[j] & is_even);
+	a.val[j] = tmp + ((1 << (window * digits - 240)) - 1) + k->val[j] - (curve->order.val[j] & is_even);
 	assert((a.val[0] & 1) != 0);
 
-	// special case 0*G:  just return zero. We don't care about constant time.
+	// special case 0*G:  no Jacobian representation, the caller returns infinity.
+	// We don't care about constant time.
 	if (!is_non_zero) {
-		point_set_infinity(res);
-		return;
+		return 0;
 	}
 
-	// Now a = k + 2^256 (mod curve->order) and a is odd.
+	// Now a = k + 2^(w*d) (mod curve->order) and a is odd, where w is the
+	// window width and d the number of digits.
 	//
 	// The idea is to bring the new a into the form.
-	// sum_{i=0..64} a[i] 16^i,  where |a[i]| < 16 and a[i] is odd.
+	// sum_{i=0..d} a[i] 2^(w*i),  where |a[i]| < 2^w and a[i] is odd.
 	// a[0] is odd, since a is odd.  If a[i] would be even, we can
-	// add 1 to it and subtract 16 from a[i-1].  Afterwards,
-	// a[64] = 1, which is the 2^256 that we added before.
+	// add 1 to it and subtract 2^w from a[i-1].  Afterwards,
+	// a[d] = 1, which is the 2^(w*d) that we added before.
 	//
-	// Since k = a - 2^256 (mod curve->order), we can compute
-	//   k*G = sum_{i=0..63} a[i] 16^i * G
+	// Since k = a - 2^(w*d) (mod curve->order), we can compute
+	//   k*G = sum_{i=0..d-1} a[i] 2^(w*i) * G
 	//
-	// We have a big table curve->cp that stores all possible
-	// values of |a[i]| 16^i * G.
-	// curve->cp[i][j] = (2*j+1) * 16^i * G
+	// The table stores all possible values of |a[i]| 2^(w*i) * G, for
+	// w = 4 curve->cp[i][j] = (2*j+1) * 16^i * G.
 
-	// now compute  res = sum_{i=0..63} a[i] * 16^i * G step by step.
-	// initial res = |a[0]| * G.  Note that a[0] = a & 0xf if (a&0x10) != 0
-	// and - (16 - (a & 0xf)) otherwise.   We can compute this as
-	//   ((a ^ (((a >> 4) & 1) - 1)) & 0xf) >> 1
+	// res = sum_{i=0..d-1} a[i] * 2^(w*i) * G is computed step by step.
+	// initial res = |a[0]| * G.  Note that a[0] = a & mask if (a >> w) & 1
+	// and - (2^w - (a & mask)) otherwise.   We can compute this as
+	//   ((a ^ (((a >> w) & 1) - 1)) & mask) >> 1
 	// since a is odd.
-	lowbits = a.val[0] & ((1 << 5) - 1);
-	lowbits ^= (lowbits >> 4) - 1;
-	lowbits &= 15;
-	curve_to_jacobian(&curve->cp[0][lowbits >> 1], &jres, prime);
-	for (i = 1; i < 64; i ++) {
-		// invariant res = sign(a[i-1]) sum_{j=0..i-1} (a[j] * 16^j * G)
-
-		// shift a by 4 places.
+	lowbits = a.val[0] & ((1 << (window + 1)) - 1);
+	lowbits ^= (lowbits >> window) - 1;
+	lowbits &= mask;
+	digit[0] = lowbits >> 1;
+	flip[0] = 0;
+	for (i = 1; i < digits; i ++) {
+		// invariant res = sign(a[i-1]) sum_{j=0..i-1} (a[j] * 2^(w*j) * G)
+
+		// shift a by w places.
 		for (j = 0; j < 8; j++) {
-			a.val[j] = (a.val[j] >> 4) | ((a.val[j + 1] & 0xf) << 26);
+			a.val[j] = (a.val[j] >> window) | ((a.val[j + 1] & mask) << (30 - window));
 		}
-		a.val[j] >>= 4;
-		// a = old(a)>>(4*i)
+		a.val[j] >>= window;
+		// a = old(a)>>(w*i)
 		// a is even iff sign(a[i-1]) = -1
 
-		lowbits = a.val[0] & ((1 << 5) - 1);
-		lowbits ^= (lowbits >> 4) - 1;
-		lowbits &= 15;
+		lowbits = a.val[0] & ((1 << (window + 1)) - 1);
+		lowbits ^= (lowbits >> window) - 1;
+		lowbits &= mask;
 		// negate last result to make signs of this round and the
 		// last round equal.
-		conditional_negate((lowbits & 1) - 1, &jres.y, prime);
+		flip[i] = (lowbits & 1) - 1;
 
 		// add odd factor
-		point_jacobian_add(&curve->cp[i][lowbits >> 1], &jres, curve);
+		digit[i] = lowbits >> 1;
 	}
-	conditional_negate(((a.val[0] >> 4) & 1) - 1, &jres.y, prime);
-	jacobian_to_curve(&jres, res, prime);
+	flip[digits] = ((a.val[0] >> window) & 1) - 1;
 	memzero(&a, sizeof(a));
+	return 1;
+}
+
+// digits of the narrowest window, the most any comb takes
+#define COMB_MAX_DIGITS ECDSA_COMB_DIGITS(ECDSA_COMB_MIN_WINDOW)
+
+// jres = k * G in Jacobian coordinates, returns 0 if k is zero
+// k must be a normalized number with 0 <= k < curve->order
+// comb is the fixed-base table to use, or NULL for curve->cp
+static int scalar_multiply_jacobian(const ecdsa_curve *curve, const ecdsa_comb *comb, const bignum256 *k, jacobian_curve_point *jres)
+{
+	assert (bn_is_less(k, &curve->order));
+	assert (bn_is_equal(&curve->prime, &secp256k1.prime));
+
+	int i;
+	uint32_t digit[COMB_MAX_DIGITS], flip[COMB_MAX_DIGITS + 1];
+	fe_curve_point cp;
+	const int window = comb ? comb->window : 4;
+	const int digits = ECDSA_COMB_DIGITS(window);
+
+	assert (window >= ECDSA_COMB_MIN_WINDOW && window <= ECDSA_COMB_MAX_WINDOW);
+
+	if (!comb_recode(curve, window, k, digit, flip)) {
+		return 0;
+	}
+	comb_lookup(curve, comb, 0, digit[0], &cp);
+	curve_to_jacobian(&cp, jres, &curve->prime);
+	for (i = 1; i < digits; i++) {
+		secp256k1_fe_cneg(&jres->y, flip[i]);
+		comb_lookup(curve, comb, i, digit[i], &cp);
+		point_jacobian_add(&cp, jres, curve);
+	}
+	secp256k1_fe_cneg(&jres->y, flip[digits]);
+	memzero(digit, sizeof(digit));
+	memzero(flip, sizeof(flip));
+	memzero(&cp, sizeof(cp));
+	return 1;
+}
+
+// Lane count requested with ecdsa_set_batch_lanes, 0 meaning automatic
+static size_t ecdsa_requested_lanes = 0;
+// 1 if the 4-lane field arithmetic runs on this CPU, -1 until checked
+static int ecdsa_x4_supported = -1;
+
+static int x4_supported(void)
+{
+	int supported = __atomic_load_n(&ecdsa_x4_supported, __ATOMIC_RELAXED);
+	if (supported < 0) {
+		supported = secp256k1_fe_x4_supported();
+		__atomic_store_n(&ecdsa_x4_supported, supported, __ATOMIC_RELAXED);
+	}
+	return supported;
+}
+
+int ecdsa_set_batch_lanes(size_t lanes)
+{
+	switch (lanes) {
+	case 0:
+	case 1:
+		break;
+	case 4:
+		if (!x4_supported()) {
+			return 0;
+		}
+		break;
+	default:
+		return 0;
+	}
+	__atomic_store_n(&ecdsa_requested_lanes, lanes, __ATOMIC_RELAXED);
+	return 1;
+}
+
+size_t ecdsa_get_batch_lanes(void)
+{
+	size_t lanes = __atomic_load_n(&ecdsa_requested_lanes, __ATOMIC_RELAXED);
+	if (lanes != 0) {
+		return lanes;
+	}
+	return x4_supported() ? 4 : 1;
+}
+
+// jres[i] = k[i] * G for four scalars at once on the 4-lane field
+// arithmetic, each lane running the steps of scalar_multiply_jacobian.
+// Sets nonzero[i] to 0 and leaves jres[i] undefined if k[i] is zero.
+static void scalar_multiply_jacobian_x4(const ecdsa_curve *curve, const ecdsa_comb *comb, const bignum256 *k, jacobian_curve_point *jres, int *nonzero)
+{
+	static const bignum256 one = {{1}};
+	int i, lane;
+	uint32_t digit[4][COMB_MAX_DIGITS], flip[4][COMB_MAX_DIGITS + 1], cond[4];
+	fe_curve_point cp;
+	jacobian_curve_point jp;
+	secp256k1_gej_x4 r;
+	secp256k1_ge_x4 p;
+	const int window = comb ? comb->window : 4;
+	const int digits = ECDSA_COMB_DIGITS(window);
+
+	assert (bn_is_equal(&curve->prime, &secp256k1.prime));
+	assert (window >= ECDSA_COMB_MIN_WINDOW && window <= ECDSA_COMB_MAX_WINDOW);
+
+	for (lane = 0; lane < 4; lane++) {
+		assert (bn_is_less(&k[lane], &curve->order));
+		// a zero scalar runs 1 * G in its lane and drops the result
+		nonzero[lane] = comb_recode(curve, window, &k[lane], digit[lane], flip[lane]);
+		if (!nonzero[lane]) {
+			comb_recode(curve, window, &one, digit[lane], flip[lane]);
+		}
+		comb_lookup(curve, comb, 0, digit[lane][0], &cp);
+		curve_to_jacobian(&cp, &jp, &curve->prime);
+		secp256k1_fe_x4_set_lane(&r.x, lane, &jp.x);
+		secp256k1_fe_x4_set_lane(&r.y, lane, &jp.y);
+		secp256k1_fe_x4_set_lane(&r.z, lane, &jp.z);
+	}
+	for (i = 1; i < digits; i++) {
+		for (lane = 0; lane < 4; lane++) {
+			cond[lane] = flip[lane][i];
+			comb_lookup(curve, comb, i, digit[lane][i], &cp);
+			secp256k1_fe_x4_set_lane(&p.x, lane, &cp.x);
+			secp256k1_fe_x4_set_lane(&p.y, lane, &cp.y);
+		}
+		secp256k1_fe_x4_cneg(&r.y, cond);
+		secp256k1_gej_x4_add_ge(&r, &p);
+	}
+	for (lane = 0; lane < 4; lane++) {
+		cond[lane] = flip[lane][digits];
+	}
+	secp256k1_fe_x4_cneg(&r.y, cond);
+	for (lane = 0; lane < 4; lane++) {
+		secp256k1_fe_x4_get_lane(&jres[lane].x, &r.x, lane);
+		secp256k1_fe_x4_get_lane(&jres[lane].y, &r.y, lane);
+		secp256k1_fe_x4_get_lane(&jres[lane].z, &r.z, lane);
+	}
+	memzero(digit, sizeof(digit));
+	memzero(flip, sizeof(flip));
+	memzero(&cp, sizeof(cp));
+	memzero(&jp, sizeof(jp));
+	memzero(&r, sizeof(r));
+	memzero(&p, sizeof(p));
+}
+
+// jres[i] = k[i] * G for count scalars, four at a time if
+// ecdsa_get_batch_lanes says so. Sets nonzero[i] to 0 and leaves jres[i]
+// undefined if k[i] is zero.
+static void scalar_multiply_jacobian_batch(const ecdsa_curve *curve, const ecdsa_comb *comb, const bignum256 *k, size_t count, jacobian_curve_point *jres, int *nonzero)
+{
+	bignum256 lanes[4];
+	jacobian_curve_point jlanes[4];
+	int nlanes[4];
+	size_t i = 0, j, n;
+
+	if (ecdsa_get_batch_lanes() == 4) {
+		for (; i + 1 < count; i += n) {
+			// a partial group fills its unused lanes with zero scalars
+			n = count - i < 4 ? count - i : 4;
+			for (j = 0; j < 4; j++) {
+				if (j < n) {
+					lanes[j] = k[i + j];
+				} else {
+					bn_zero(&lanes[j]);
+				}
+			}
+			scalar_multiply_jacobian_x4(curve, comb, lanes, jlanes, nlanes);
+			for (j = 0; j < n; j++) {
+				jres[i + j] = jlanes[j];
+				nonzero[i + j] = nlanes[j];
+			}
+		}
+		memzero(lanes, sizeof(lanes));
+		memzero(jlanes, sizeof(jlanes));
+	}
+	for (; i < count; i++) {
+		nonzero[i] = scalar_multiply_jacobian(curve, comb, &k[i], &jres[i]);
+	}
+}
+
+// res = k * G
+// k must be a normalized number with 0 <= k < curve->order
+void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res)
+{
+	scalar_multiply_comb(curve, DEFAULT_COMB, k, res);
+}
+
+// res = k * G using the fixed-base table comb, or curve->cp if comb is NULL
+// k must be a normalized number with 0 <= k < curve->order
+void scalar_multiply_comb(const ecdsa_curve *curve, const ecdsa_comb *comb, const bignum256 *k, curve_point *res)
+{
+	jacobian_curve_point jres;
+
+	// special case 0*G:  just return zero. We don't care about constant time.
+	if (!scalar_multiply_jacobian(curve, comb, k, &jres)) {
+		point_set_infinity(res);
+		return;
+	}
+	jacobian_to_curve(&jres, res);
 	memzero(&jres, sizeof(jres));
 }
 
+// Fills table with the ECDSA_COMB_SIZE(window) points of the fixed-base
+// table for window, see ecdsa_comb. Runs in variable time.
+void ecdsa_comb_init(const ecdsa_curve *curve, int window, fe_curve_point *table)
+{
+	assert (window >= ECDSA_COMB_MIN_WINDOW && window <= ECDSA_COMB_MAX_WINDOW);
+
+	curve_point base, twice, p;
+	int i, j, count = 1 << (window - 1);
+
+	point_copy(&curve->G, &base);
+	for (i = 0; i < ECDSA_COMB_DIGITS(window); i++) {
+		// base = 2^(window*i) * G
+		point_copy(&base, &twice);
+		point_double(curve, &twice);
+		point_copy(&base, &p);
+		for (j = 0; j < count; j++) {
+			curve_to_fe(&p, &table[(i << (window - 1)) + j]);
+			point_add(curve, &twice, &p);
+		}
+		for (j = 0; j < window; j++) {
+			point_double(curve, &base);
+		}
+	}
+}
+
+// res[i] = k[i] * G for count scalars
+// Points are converted to affine coordinates in groups that share a single
+// field inversion. Each k[i] must be a normalized number with 0 <= k[i] < curve->order.
+void scalar_multiply_batch(const ecdsa_curve *curve, const bignum256 *k, curve_point *res, size_t count)
+{
+	jacobian_curve_point jres[SCALAR_MULTIPLY_BATCH];
+	secp256k1_fe zinv[SCALAR_MULTIPLY_BATCH], scratch[SCALAR_MULTIPLY_BATCH];
+	size_t index[SCALAR_MULTIPLY_BATCH];
+	int nonzero[SCALAR_MULTIPLY_BATCH];
+	size_t base, i, n, points;
+
+	for (base = 0; base < count; base += n) {
+		n = count - base < SCALAR_MULTIPLY_BATCH ? count - base : SCALAR_MULTIPLY_BATCH;
+		scalar_multiply_jacobian_batch(curve, DEFAULT_COMB, &k[base], n, jres, nonzero);
+		points = 0;
+		for (i = 0; i < n; i++) {
+			if (nonzero[i]) {
+				jres[points] = jres[i];
+				zinv[points] = jres[i].z;
+				index[points] = base + i;
+				points++;
+			} else {
+				point_set_infinity(&res[base + i]);
+			}
+		}
+		secp256k1_fe_inv_batch(zinv, scratch, points);
+		for (i = 0; i < points; i++) {
+			jacobian_to_curve_zinv(&jres[i], &zinv[i], &res[index[i]]);
+		}
+	}
+	memzero(jres, sizeof(jres));
+	memzero(zinv, sizeof(zinv));
+}
+
+// Width of the signed digits used by point_multiply_double_var for G, and
+// for public keys without a precomputed table. The odd multiples 1..15 of
+// G and 2^128 G are curve->cp[0] and curve->cp[32].
+#define VERIFY_WNAF_WINDOW 5
+// 128-bit scalars need at most 129 digits
+#define VERIFY_WNAF_LENGTH 130
+// signatures that ecdsa_verify_digest_batch processes with shared inversions
+#define VERIFY_BATCH 16
+
+// Writes the width-w NAF of a non-negative a < 2^(len - 1): every non-zero
+// digit is odd, below 2^(w-1) in absolute value and followed by at least
+// w - 1 zeros. Returns the number of digits up to the last non-zero one.
+// Runs in variable time.
+static int wnaf_var(int *wnaf, int len, const uint64_t a[4], int w)
+{
+	int bit = 0, last = -1, now, carry = 0, word;
+	uint64_t bits;
+
+	memset(wnaf, 0, len * sizeof(int));
+	while (bit < len) {
+		if ((int)((a[bit / 64] >> (bit % 64)) & 1) == carry) {
+			bit++;
+			continue;
+		}
+		now = w < len - bit ? w : len - bit;
+		bits = a[bit / 64] >> (bit % 64);
+		if (bit % 64 + now > 64 && bit / 64 < 3) {
+			bits |= a[bit / 64 + 1] << (64 - bit % 64);
+		}
+		word = (int)(bits & ((1u << now) - 1)) + carry;
+		carry = (word >> (w - 1)) & 1;
+		word -= carry << w;
+		wnaf[bit] = word;
+		last = bit;
+		bit += now;
+	}
+	assert(carry == 0);
+	return last + 1;
+}
+
+// p2 += p1 where p2 may be the point at infinity, in variable time
+static void point_jacobian_add_var(const fe_curve_point *p1, jacobian_curve_point *p2, int *infinity, const ecdsa_curve *curve)
+{
+	if (*infinity) {
+		p2->x = p1->x;
+		p2->y = p1->y;
+		p2->z.n[0] = 1;
+		p2->z.n[1] = p2->z.n[2] = p2->z.n[3] = 0;
+		*infinity = 0;
+		return;
+	}
+	// p1 = -p2 yields z = 0
+	point_jacobian_add(p1, p2, curve);
+	*infinity = secp256k1_fe_is_zero(&p2->z);
+}
+
+// jres = u1 * G + u2 * q for public u1, u2 and q, in variable time, given
+// the odd multiples 1, 3, ..., 2^(window-1) - 1 of q in qmult.
+// Returns 0 if the result is the point at infinity.
+static int point_multiply_double_var(const ecdsa_curve *curve, const secp256k1_scalar *u1, const secp256k1_scalar *u2, const fe_curve_point *qmult, int window, jacobian_curve_point *jres)
+{
+	// beta^3 = 1 mod p, with lambda * (x, y) = (beta * x, y)
+	static const secp256k1_fe beta = {{
+		0xC1396C28719501EEULL, 0x9CF0497512F58995ULL, 0x6E64479EAC3434E9ULL, 0x7AE96A2B657C0710ULL,
+	}};
+	// Four interleaved digit streams share the doublings:
+	//   u1 = g[0] + g[1] * 2^128 with the tables for G and 2^128 G,
+	//   u2 = k[0] + k[1] * lambda with odd multiples of q and lambda q.
+	int wnaf[4][VERIFY_WNAF_LENGTH], length[4], negate[2];
+	fe_curve_point point;
+	secp256k1_scalar k[2];
+	uint64_t limbs[4] = {0};
+	int i, j, digit, top = 0, infinity = 1;
+
+	limbs[0] = u1->n[0];
+	limbs[1] = u1->n[1];
+	length[0] = wnaf_var(wnaf[0], VERIFY_WNAF_LENGTH, limbs, VERIFY_WNAF_WINDOW);
+	limbs[0] = u1->n[2];
+	limbs[1] = u1->n[3];
+	length[1] = wnaf_var(wnaf[1], VERIFY_WNAF_LENGTH, limbs, VERIFY_WNAF_WINDOW);
+
+	secp256k1_scalar_split_lambda(&k[0], &k[1], u2);
+	for (i = 0; i < 2; i++) {
+		// work with the short one of k and -k, negating the points instead
+		negate[i] = secp256k1_scalar_is_high(&k[i]);
+		if (negate[i]) {
+			secp256k1_scalar_negate(&k[i], &k[i]);
+		}
+		length[2 + i] = wnaf_var(wnaf[2 + i], VERIFY_WNAF_LENGTH, k[i].n, window);
+	}
+
+	for (i = 0; i < 4; i++) {
+		if (length[i] > top) {
+			top = length[i];
+		}
+	}
+	for (i = top - 1; i >= 0; i--) {
+		if (!infinity) {
+			point_jacobian_double(jres, curve);
+		}
+		for (j = 0; j < 4; j++) {
+			digit = wnaf[j][i];
+			if (digit == 0) {
+				continue;
+			}
+			if (j < 2) {
+				curve_to_fe(&curve->cp[32 * j][(abs(digit) - 1) / 2], &point);
+			} else {
+				point = qmult[(abs(digit) - 1) / 2];
+				if (j == 3) {
+					secp256k1_fe_mul(&point.x, &point.x, &beta);
+				}
+				if (negate[j - 2]) {
+					digit = -digit;
+				}
+			}
+			if (digit < 0) {
+				secp256k1_fe_negate(&point.y, &point.y);
+			}
+			point_jacobian_add_var(&point, jres, &infinity, curve);
+		}
+	}
+	return !infinity;
+}
+
 int ecdh_multiply(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *pub_key, uint8_t *session_key)
 {
 	curve_point point;
@@ -649,44 +1073,118 @@ int ecdh_multiply(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8
 	return 0;
 }
 
-void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash, rfc6979_state *state) {
-	uint8_t bx[2*32];
-	uint8_t buf[32 + 1 + 2*32];
+// ctx = SHA-256 after compressing blocks full blocks into state
+static void sha256_resume(SHA256_CTX *ctx, const uint32_t state[8], uint64_t blocks)
+{
+	memcpy(ctx->state, state, sizeof(ctx->state));
+	ctx->bitcount = blocks * SHA256_BLOCK_LENGTH * 8;
+}
 
-	memcpy(bx, priv_key, 32);
-	memcpy(bx+32, hash, 32);
+// hmac = HMAC-SHA256 of the message whose inner hash is in ctx, for the key
+// with outer pad digest opad
+static void hmac_sha256_finish(const uint32_t opad[8], SHA256_CTX *ctx, uint8_t hmac[32])
+{
+	uint8_t inner[SHA256_DIGEST_LENGTH];
 
-	memset(state->v, 1, sizeof(state->v));
-	memset(state->k, 0, sizeof(state->k));
+	sha256_Final(ctx, inner);
+	sha256_resume(ctx, opad, 1);
+	sha256_Update(ctx, inner, sizeof(inner));
+	sha256_Final(ctx, hmac);
+	memzero(inner, sizeof(inner));
+}
 
-	memcpy(buf, state->v, sizeof(state->v));
-	buf[sizeof(state->v)] = 0x00;
-	memcpy(buf + sizeof(state->v) + 1, bx, 64);
-	hmac_sha256(state->k, sizeof(state->k), buf, sizeof(buf), state->k);
-	hmac_sha256(state->k, sizeof(state->k), state->v, sizeof(state->v), state->v);
+// hmac = HMAC-SHA256(k, msg) with the pad digests of k
+static void hmac_sha256_prepared(const uint32_t opad[8], const uint32_t ipad[8], const uint8_t *msg, size_t msg_len, uint8_t hmac[32])
+{
+	SHA256_CTX ctx;
+
+	sha256_resume(&ctx, ipad, 1);
+	sha256_Update(&ctx, msg, msg_len);
+	hmac_sha256_finish(opad, &ctx, hmac);
+	memzero(&ctx, sizeof(ctx));
+}
+
+// state->v = HMAC(state->k, state->v)
+static void rfc6979_update_v(rfc6979_state *state)
+{
+	hmac_sha256_prepared(state->opad, state->ipad, state->v, sizeof(state->v), state->v);
+}
+
+// state->k = HMAC(state->k, state->v || tag || priv_key || hash), where the
+// message is v alone if priv_key is NULL, and prepares the new k
+static void rfc6979_update_k(rfc6979_state *state, uint8_t tag, const uint8_t *priv_key, const uint8_t *hash)
+{
+	uint8_t buf[32 + 1 + 2*32];
+	size_t len = sizeof(state->v) + 1;
 
 	memcpy(buf, state->v, sizeof(state->v));
-	buf[sizeof(state->v)] = 0x01;
-	memcpy(buf + sizeof(state->v) + 1, bx, 64);
-	hmac_sha256(state->k, sizeof(state->k), buf, sizeof(buf), state->k);
-	hmac_sha256(state->k, sizeof(state->k), state->v, sizeof(state->v), state->v);
+	buf[sizeof(state->v)] = tag;
+	if (priv_key) {
+		memcpy(buf + len, priv_key, 32);
+		memcpy(buf + len + 32, hash, 32);
+		len += 64;
+	}
+	hmac_sha256_prepared(state->opad, state->ipad, buf, len, state->k);
+	hmac_sha256_prepare(state->k, sizeof(state->k), state->opad, state->ipad);
+	memzero(buf, sizeof(buf));
+}
+
+void init_rfc6979_key(const uint8_t *priv_key, rfc6979_key *key) {
+	uint8_t k[32], buf[32 + 1 + 31];
+	uint32_t ipad[8];
+	SHA256_CTX ctx;
+
+	// the first k is HMAC(0, v || 0x00 || priv_key || hash) with v = 0x01...,
+	// whose first two inner blocks are the same for every hash
+	memset(k, 0, sizeof(k));
+	hmac_sha256_prepare(k, sizeof(k), key->opad, ipad);
+	memset(buf, 1, 32);
+	buf[32] = 0x00;
+	memcpy(buf + 33, priv_key, 31);
+	sha256_resume(&ctx, ipad, 1);
+	sha256_Update(&ctx, buf, sizeof(buf));
+	memcpy(key->inner, ctx.state, sizeof(key->inner));
+	memcpy(key->priv_key, priv_key, 32);
 
-	memzero(bx, sizeof(bx));
 	memzero(buf, sizeof(buf));
+	memzero(ipad, sizeof(ipad));
+	memzero(&ctx, sizeof(ctx));
+}
+
+void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash, rfc6979_state *state) {
+	rfc6979_key key;
+
+	init_rfc6979_key(priv_key, &key);
+	init_rfc6979_with_key(&key, hash, state);
+	memzero(&key, sizeof(key));
+}
+
+void init_rfc6979_with_key(const rfc6979_key *key, const uint8_t *hash, rfc6979_state *state) {
+	SHA256_CTX ctx;
+
+	memset(state->v, 1, sizeof(state->v));
+
+	// k = HMAC(0, v || 0x00 || priv_key || hash), resumed after the key's part
+	sha256_resume(&ctx, key->inner, 2);
+	sha256_Update(&ctx, key->priv_key + 31, 1);
+	sha256_Update(&ctx, hash, 32);
+	hmac_sha256_finish(key->opad, &ctx, state->k);
+	hmac_sha256_prepare(state->k, sizeof(state->k), state->opad, state->ipad);
+	rfc6979_update_v(state);
+
+	rfc6979_update_k(state, 0x01, key->priv_key, hash);
+	rfc6979_update_v(state);
+
+	memzero(&ctx, sizeof(ctx));
 }
 
 // generate next number from deterministic random number generator
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *state)
 {
-	uint8_t buf[32 + 1];
-
-	hmac_sha256(state->k, sizeof(state->k), state->v, sizeof(state->v), state->v);
-	memcpy(buf, state->v, sizeof(state->v));
-	buf[sizeof(state->v)] = 0x00;
-	hmac_sha256(state->k, sizeof(state->k), buf, sizeof(state->v) + 1, state->k);
-	hmac_sha256(state->k, sizeof(state->k), state->v, sizeof(state->v), state->v);
-	memcpy(rnd, buf, 32);
-	memzero(buf, sizeof(buf));
+	rfc6979_update_v(state);
+	memcpy(rnd, state->v, 32);
+	rfc6979_update_k(state, 0x00, NULL, NULL);
+	rfc6979_update_v(state);
 }
 
 // generate K in a deterministic way, according to RFC6979
@@ -711,29 +1209,24 @@ int ecdsa_sign(const ecdsa_curve *curve, HasherType hasher_sign, const uint8_t *
 
 }
 
-// uses secp256k1 curve
-// priv_key is a 32 byte big endian stored number
-// sig is 64 bytes long array for the signature
-// digest is 32 bytes of digest
-// is_canonical is an optional function that checks if the signature
-// conforms to additional coin-specific rules.
-int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *digest, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]))
+// signs with the nonces of rng, which it erases
+static int ecdsa_sign_digest_rng(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *digest, rfc6979_state *rng, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]))
 {
 	int i;
 	curve_point R;
-	bignum256 k, z, randk;
-	bignum256 *s = &R.y;
+	bignum256 k, randk;
+	secp256k1_scalar sk, srandk, sr, ss, sz, spriv;
 	uint8_t by; // signature recovery byte
 
-	rfc6979_state rng;
-	init_rfc6979(priv_key, digest, &rng);
+	assert (bn_is_equal(&curve->order, &secp256k1.order));
 
-	bn_read_be(digest, &z);
+	secp256k1_scalar_set_b32(&sz, digest);
+	secp256k1_scalar_set_b32(&spriv, priv_key);
 
 	for (i = 0; i < 10000; i++) {
 
 		// generate K deterministically
-		generate_k_rfc6979(&k, &rng);
+		generate_k_rfc6979(&k, rng);
 		// if k is too big or too small, we don't like it
 		if (bn_is_zero(&k) || !bn_is_less(&k, &curve->order)) {
 			continue;
@@ -751,30 +1244,30 @@ int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key, const u
 		if (bn_is_zero(&R.x)) {
 			continue;
 		}
+		secp256k1_scalar_set_bn(&sr, &R.x);
 
 		// randomize operations to counter side-channel attacks
 		generate_k_random(&randk, &curve->order);
-		bn_multiply(&randk, &k, &curve->order); // k*rand
-		bn_inverse(&k, &curve->order);         // (k*rand)^-1
-		bn_read_be(priv_key, s);               // priv
-		bn_multiply(&R.x, s, &curve->order);   // R.x*priv
-		bn_add(s, &z);                         // R.x*priv + z
-		bn_multiply(&k, s, &curve->order);     // (k*rand)^-1 (R.x*priv + z)
-		bn_multiply(&randk, s, &curve->order);  // k^-1 (R.x*priv + z)
-		bn_mod(s, &curve->order);
+		secp256k1_scalar_set_bn(&srandk, &randk);
+		secp256k1_scalar_set_bn(&sk, &k);
+		secp256k1_scalar_mul(&sk, &sk, &srandk);       // k*rand
+		secp256k1_scalar_inverse(&sk, &sk);            // (k*rand)^-1
+		secp256k1_scalar_mul_add(&ss, &sr, &spriv, &sz); // R.x*priv + z
+		secp256k1_scalar_mul(&ss, &sk, &ss);           // (k*rand)^-1 (R.x*priv + z)
+		secp256k1_scalar_mul(&ss, &srandk, &ss);       // k^-1 (R.x*priv + z)
 		// if s is zero, we retry
-		if (bn_is_zero(s)) {
+		if (secp256k1_scalar_is_zero(&ss)) {
 			continue;
 		}
 
 		// if S > order/2 => S = -S
-		if (bn_is_less(&curve->order_half, s)) {
-			bn_subtract(&curve->order, s, s);
+		if (secp256k1_scalar_is_high(&ss)) {
+			secp256k1_scalar_negate(&ss, &ss);
 			by ^= 1;
 		}
 		// we are done, R.x and s is the result signature
 		bn_write_be(&R.x, sig);
-		bn_write_be(s, sig + 32);
+		secp256k1_scalar_get_b32(sig + 32, &ss);
 
 		// check if the signature is acceptable or retry
 		if (is_canonical && !is_canonical(by, sig)) {
@@ -787,7 +1280,10 @@ int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key, const u
 
 		memzero(&k, sizeof(k));
 		memzero(&randk, sizeof(randk));
-		memzero(&rng, sizeof(rng));
+		memzero(&sk, sizeof(sk));
+		memzero(&srandk, sizeof(srandk));
+		memzero(&spriv, sizeof(spriv));
+		memzero(rng, sizeof(*rng));
 		return 0;
 	}
 
@@ -795,10 +1291,131 @@ int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key, const u
 	// -> fail with an error
 	memzero(&k, sizeof(k));
 	memzero(&randk, sizeof(randk));
-	memzero(&rng, sizeof(rng));
+	memzero(&sk, sizeof(sk));
+	memzero(&srandk, sizeof(srandk));
+	memzero(&spriv, sizeof(spriv));
+	memzero(rng, sizeof(*rng));
 	return -1;
 }
 
+// uses secp256k1 curve
+// priv_key is a 32 byte big endian stored number
+// sig is 64 bytes long array for the signature
+// digest is 32 bytes of digest
+// is_canonical is an optional function that checks if the signature
+// conforms to additional coin-specific rules.
+int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *digest, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]))
+{
+	rfc6979_state rng;
+	init_rfc6979(priv_key, digest, &rng);
+	return ecdsa_sign_digest_rng(curve, priv_key, digest, &rng, sig, pby, is_canonical);
+}
+
+// same as ecdsa_sign_digest for the private key of key, which holds the
+// nonce derivation's per-key part
+int ecdsa_sign_digest_key(const ecdsa_curve *curve, const rfc6979_key *key, const uint8_t *digest, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]))
+{
+	rfc6979_state rng;
+	init_rfc6979_with_key(key, digest, &rng);
+	return ecdsa_sign_digest_rng(curve, key->priv_key, digest, &rng, sig, pby, is_canonical);
+}
+
+// sigs + 64 * i = ecdsa_sign_digest(curve, priv_keys + 32 * i, digests + 32 * i)
+// for count private keys, with the recovery bytes in pbys if it is not NULL.
+// The R points of up to SCALAR_MULTIPLY_BATCH signatures share one field
+// inversion and their blinded nonces one scalar inversion. Returns 0, or -1
+// if some signature failed; its bytes are zero then.
+int ecdsa_sign_digest_batch(const ecdsa_curve *curve, const uint8_t *priv_keys, const uint8_t *digests, size_t count, uint8_t *sigs, uint8_t *pbys)
+{
+	jacobian_curve_point jres[SCALAR_MULTIPLY_BATCH];
+	secp256k1_fe zinv[SCALAR_MULTIPLY_BATCH], fscratch[SCALAR_MULTIPLY_BATCH];
+	secp256k1_scalar sk[SCALAR_MULTIPLY_BATCH], srandk[SCALAR_MULTIPLY_BATCH], sscratch[SCALAR_MULTIPLY_BATCH];
+	secp256k1_scalar sr, ss, sz, spriv;
+	rfc6979_state rng;
+	bignum256 k[SCALAR_MULTIPLY_BATCH], randk;
+	curve_point R;
+	size_t base, i, n;
+	int nonzero[SCALAR_MULTIPLY_BATCH];
+	int result = 0, retry;
+	uint8_t by;
+
+	assert (bn_is_equal(&curve->order, &secp256k1.order));
+
+	for (base = 0; base < count; base += n) {
+		n = count - base < SCALAR_MULTIPLY_BATCH ? count - base : SCALAR_MULTIPLY_BATCH;
+		for (i = 0; i < n; i++) {
+			// the first valid nonce of each signature, as in ecdsa_sign_digest
+			init_rfc6979(priv_keys + 32 * (base + i), digests + 32 * (base + i), &rng);
+			do {
+				generate_k_rfc6979(&k[i], &rng);
+			} while (bn_is_zero(&k[i]) || !bn_is_less(&k[i], &curve->order));
+
+			// randomize operations to counter side-channel attacks
+			generate_k_random(&randk, &curve->order);
+			secp256k1_scalar_set_bn(&srandk[i], &randk);
+			secp256k1_scalar_set_bn(&sk[i], &k[i]);
+			secp256k1_scalar_mul(&sk[i], &sk[i], &srandk[i]); // k*rand
+		}
+		scalar_multiply_jacobian_batch(curve, DEFAULT_COMB, k, n, jres, nonzero);
+		for (i = 0; i < n; i++) {
+			zinv[i] = jres[i].z;
+		}
+		secp256k1_fe_inv_batch(zinv, fscratch, n);
+		secp256k1_scalar_inverse_batch(sk, sscratch, n);  // (k*rand)^-1
+
+		for (i = 0; i < n; i++) {
+			uint8_t *sig = sigs + 64 * (base + i);
+
+			jacobian_to_curve_zinv(&jres[i], &zinv[i], &R);
+			by = R.y.val[0] & 1;
+			// r = (rx mod n)
+			if (!bn_is_less(&R.x, &curve->order)) {
+				bn_subtract(&R.x, &curve->order, &R.x);
+				by |= 2;
+			}
+			retry = bn_is_zero(&R.x);
+			if (!retry) {
+				secp256k1_scalar_set_bn(&sr, &R.x);
+				secp256k1_scalar_set_b32(&sz, digests + 32 * (base + i));
+				secp256k1_scalar_set_b32(&spriv, priv_keys + 32 * (base + i));
+				secp256k1_scalar_mul_add(&ss, &sr, &spriv, &sz);  // R.x*priv + z
+				secp256k1_scalar_mul(&ss, &sk[i], &ss);          // (k*rand)^-1 (R.x*priv + z)
+				secp256k1_scalar_mul(&ss, &srandk[i], &ss);      // k^-1 (R.x*priv + z)
+				retry = secp256k1_scalar_is_zero(&ss);
+			}
+			if (retry) {
+				// the next nonces of this signature, one at a time
+				if (ecdsa_sign_digest(curve, priv_keys + 32 * (base + i), digests + 32 * (base + i), sig, &by, NULL) != 0) {
+					memzero(sig, 64);
+					result = -1;
+				}
+			} else {
+				// if S > order/2 => S = -S
+				if (secp256k1_scalar_is_high(&ss)) {
+					secp256k1_scalar_negate(&ss, &ss);
+					by ^= 1;
+				}
+				bn_write_be(&R.x, sig);
+				secp256k1_scalar_get_b32(sig + 32, &ss);
+			}
+			if (pbys) {
+				pbys[base + i] = by;
+			}
+		}
+	}
+
+	memzero(jres, sizeof(jres));
+	memzero(zinv, sizeof(zinv));
+	memzero(sk, sizeof(sk));
+	memzero(srandk, sizeof(srandk));
+	memzero(&ss, sizeof(ss));
+	memzero(&spriv, sizeof(spriv));
+	memzero(&rng, sizeof(rng));
+	memzero(k, sizeof(k));
+	memzero(&randk, sizeof(randk));
+	return result;
+}
+
 void ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key, uint8_t *pub_key)
 {
 	curve_point R;
@@ -813,6 +1430,31 @@ void ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key, u
 	memzero(&k, sizeof(k));
 }
 
+// pub_keys[33 i] = compressed public key of priv_keys[32 i] for count keys
+// Every private key must be valid.
+void ecdsa_get_public_key33_batch(const ecdsa_curve *curve, const uint8_t *priv_keys, size_t count, uint8_t *pub_keys)
+{
+	curve_point R[SCALAR_MULTIPLY_BATCH];
+	bignum256 k[SCALAR_MULTIPLY_BATCH];
+	size_t base, i, n;
+
+	for (base = 0; base < count; base += n) {
+		n = count - base < SCALAR_MULTIPLY_BATCH ? count - base : SCALAR_MULTIPLY_BATCH;
+		for (i = 0; i < n; i++) {
+			bn_read_be(priv_keys + 32 * (base + i), &k[i]);
+		}
+		// compute k*G
+		scalar_multiply_batch(curve, k, R, n);
+		for (i = 0; i < n; i++) {
+			uint8_t *pub_key = pub_keys + 33 * (base + i);
+			pub_key[0] = 0x02 | (R[i].y.val[0] & 0x01);
+			bn_write_be(&R[i].x, pub_key + 1);
+		}
+	}
+	memzero(R, sizeof(R));
+	memzero(k, sizeof(k));
+}
+
 void ecdsa_get_public_key65(const ecdsa_curve *curve, const uint8_t *priv_key, uint8_t *pub_key)
 {
 	curve_point R;
@@ -875,8 +1517,34 @@ void ecdsa_get_address_segwit_p2sh_raw(const uint8_t *pub_key, uint32_t version,
 	hasher_Raw(hasher_pubkey, buf, 22, addr_raw + prefix_len);
 }
 
+// y = the root of x^3 + b with the parity of odd on secp256k1, computed with
+// the square root's addition chain; returns 0 if x is not on the curve
+static int uncompress_coords_secp256k1(const ecdsa_curve *curve, uint8_t odd, const bignum256 *x, bignum256 *y)
+{
+	secp256k1_fe fx, fy, fb;
+	int on_curve;
+
+	// y^2 = x^3 + b
+	secp256k1_fe_set_bn(&fx, x);
+	secp256k1_fe_set_bn(&fb, &curve->b);
+	secp256k1_fe_sqr(&fy, &fx);
+	secp256k1_fe_mul(&fy, &fy, &fx);
+	secp256k1_fe_add(&fy, &fy, &fb);
+	on_curve = secp256k1_fe_sqrt(&fy, &fy);
+	secp256k1_fe_get_bn(y, &fy);
+	if ((odd & 0x01) != (y->val[0] & 1)) {
+		bn_subtract(&curve->prime, y, y);   // y = -y
+	}
+	return on_curve;
+}
+
 void uncompress_coords(const ecdsa_curve *curve, uint8_t odd, const bignum256 *x, bignum256 *y)
 {
+	if (curve->a == 0 && bn_is_equal(&curve->prime, &secp256k1.prime)) {
+		uncompress_coords_secp256k1(curve, odd, x, y);
+		return;
+	}
+
 	// y^2 = x^3 + a*x + b
 	memcpy(y, x, sizeof(bignum256));         // y is x
 	bn_multiply(x, y, &curve->prime);        // y is x^2
@@ -966,8 +1634,11 @@ int ecdsa_verify(const ecdsa_curve *curve, HasherType hasher_sign, const uint8_t
 int ecdsa_recover_pub_from_sig (const ecdsa_curve *curve, uint8_t *pub_key, const uint8_t *sig, const uint8_t *digest, int recid)
 {
 	bignum256 r, s, e;
+	secp256k1_scalar sr, se;
 	curve_point cp, cp2;
 
+	assert (bn_is_equal(&curve->order, &secp256k1.order));
+
 	// read r and s
 	bn_read_be(sig, &r);
 	bn_read_be(sig + 32, &s);
@@ -991,12 +1662,13 @@ int ecdsa_recover_pub_from_sig (const ecdsa_curve *curve, uint8_t *pub_key, cons
 		return 1;
 	}
 	// e = -digest
-	bn_read_be(digest, &e);
-	bn_subtractmod(&curve->order, &e, &e, &curve->order);
-	bn_fast_mod(&e, &curve->order);
-	bn_mod(&e, &curve->order);
+	secp256k1_scalar_set_b32(&se, digest);
+	secp256k1_scalar_negate(&se, &se);
+	secp256k1_scalar_get_bn(&e, &se);
 	// r := r^-1
-	bn_inverse(&r, &curve->order);
+	secp256k1_scalar_set_bn(&sr, &r);
+	secp256k1_scalar_inverse(&sr, &sr);
+	secp256k1_scalar_get_bn(&r, &sr);
 	// cp := s * R = s * k *G
 	point_multiply(curve, &s, &cp, &cp);
 	// cp2 := -digest * G
@@ -1011,61 +1683,249 @@ int ecdsa_recover_pub_from_sig (const ecdsa_curve *curve, uint8_t *pub_key, cons
 	return 0;
 }
 
-// returns 0 if verification succeeded
-int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key, const uint8_t *sig, const uint8_t *digest)
+// returns 2 if r or s of sig is out of range, 0 otherwise
+static int ecdsa_check_sig_range(const ecdsa_curve *curve, const uint8_t *sig)
 {
-	curve_point pub, res;
-	bignum256 r, s, z;
-
-	if (!ecdsa_read_pubkey(curve, pub_key, &pub)) {
-		return 1;
-	}
+	bignum256 r, s;
+	int result = 0;
 
 	bn_read_be(sig, &r);
 	bn_read_be(sig + 32, &s);
-
-	bn_read_be(digest, &z);
-
 	if (bn_is_zero(&r) || bn_is_zero(&s) ||
 		(!bn_is_less(&r, &curve->order)) ||
-		(!bn_is_less(&s, &curve->order))) return 2;
+		(!bn_is_less(&s, &curve->order))) result = 2;
+	memzero(&r, sizeof(r));
+	memzero(&s, sizeof(s));
+	return result;
+}
+
+// verifies sig, whose r and s are in range, given sinv = s^-1
+static int ecdsa_verify_digest_sinv(const ecdsa_curve *curve, const fe_curve_point *qmult, int window, const uint8_t *sig, const uint8_t *digest, const secp256k1_scalar *sinv)
+{
+	jacobian_curve_point jres;
+	bignum256 r;
+	secp256k1_scalar u1, u2;
+	secp256k1_fe rz, zz;
 
-	bn_inverse(&s, &curve->order); // s^-1
-	bn_multiply(&s, &z, &curve->order); // z*s^-1
-	bn_mod(&z, &curve->order);
-	bn_multiply(&r, &s, &curve->order); // r*s^-1
-	bn_mod(&s, &curve->order);
+	assert (bn_is_equal(&curve->order, &secp256k1.order));
+
+	bn_read_be(sig, &r);
+	secp256k1_scalar_set_b32(&u1, digest);
+	secp256k1_scalar_mul(&u1, &u1, sinv); // z*s^-1
+	secp256k1_scalar_set_b32(&u2, sig);
+	secp256k1_scalar_mul(&u2, &u2, sinv); // r*s^-1
 
 	int result = 0;
-	if (bn_is_zero(&z)) {
+	if (secp256k1_scalar_is_zero(&u1)) {
 		// our message hashes to zero
 		// I don't expect this to happen any time soon
 		result = 3;
+	} else if (!point_multiply_double_var(curve, &u1, &u2, qmult, window, &jres)) {
+		// u1 * G + u2 * pub is the point at infinity
+		result = 5;
 	} else {
-		scalar_multiply(curve, &z, &res);
-	}
-
-	if (result == 0) {
-		// both pub and res can be infinity, can have y = 0 OR can be equal -> false negative
-		point_multiply(curve, &s, &pub, &pub);
-		point_add(curve, &pub, &res);
-		bn_mod(&(res.x), &curve->order);
-		// signature does not match
-		if (!bn_is_equal(&res.x, &r)) {
+		// R.x mod n = r for R = (X/Z^2, Y/Z^3), without leaving Jacobian
+		// coordinates: X = r Z^2, or X = (r + n) Z^2 if r + n < p
+		secp256k1_fe_sqr(&zz, &jres.z);
+		secp256k1_fe_set_bn(&rz, &r);
+		secp256k1_fe_mul(&rz, &rz, &zz);
+		secp256k1_fe_sub(&rz, &jres.x, &rz);
+		if (!secp256k1_fe_is_zero(&rz)) {
 			result = 5;
+			bn_add(&r, &curve->order);
+			if (bn_is_less(&r, &curve->prime)) {
+				secp256k1_fe_set_bn(&rz, &r);
+				secp256k1_fe_mul(&rz, &rz, &zz);
+				secp256k1_fe_sub(&rz, &jres.x, &rz);
+				if (secp256k1_fe_is_zero(&rz)) {
+					result = 0;
+				}
+			}
 		}
 	}
 
-	memzero(&pub, sizeof(pub));
-	memzero(&res, sizeof(res));
+	memzero(&jres, sizeof(jres));
 	memzero(&r, sizeof(r));
-	memzero(&s, sizeof(s));
-	memzero(&z, sizeof(z));
 
 	// all OK
 	return result;
 }
 
+// Verifies sig against the public key whose odd multiples 1, 3, ...,
+// 2^(window-1) - 1 are qmult, with the result codes of ecdsa_verify_digest
+static int ecdsa_verify_digest_multiples(const ecdsa_curve *curve, const fe_curve_point *qmult, int window, const uint8_t *sig, const uint8_t *digest)
+{
+	secp256k1_scalar sinv;
+	int result = ecdsa_check_sig_range(curve, sig);
+
+	if (result) {
+		return result;
+	}
+	secp256k1_scalar_set_b32(&sinv, sig + 32);
+	secp256k1_scalar_inverse(&sinv, &sinv); // s^-1
+	return ecdsa_verify_digest_sinv(curve, qmult, window, sig, digest, &sinv);
+}
+
+// returns 0 if verification succeeded
+int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key, const uint8_t *sig, const uint8_t *digest)
+{
+	curve_point pub;
+	fe_curve_point qmult[1 << (VERIFY_WNAF_WINDOW - 2)];
+	int result;
+
+	if (!ecdsa_read_pubkey(curve, pub_key, &pub)) {
+		return 1;
+	}
+	point_multiply_table(curve, &pub, qmult, 1 << (VERIFY_WNAF_WINDOW - 2));
+	result = ecdsa_verify_digest_multiples(curve, qmult, VERIFY_WNAF_WINDOW, sig, digest);
+	memzero(&pub, sizeof(pub));
+	memzero(qmult, sizeof(qmult));
+	return result;
+}
+
+// results[i] = ecdsa_verify_digest(curve, pub_keys + 33 * i, sigs + 64 * i,
+// digests + 32 * i) for count compressed public keys. The inverses of s and
+// the affine odd multiples of the public keys take one inversion per
+// VERIFY_BATCH signatures each.
+void ecdsa_verify_digest_batch(const ecdsa_curve *curve, const uint8_t *pub_keys, const uint8_t *sigs, const uint8_t *digests, size_t count, int *results)
+{
+	const int multiples = 1 << (VERIFY_WNAF_WINDOW - 2);
+	curve_point pub[VERIFY_BATCH];
+	fe_curve_point qmult[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	jacobian_curve_point jp[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	secp256k1_fe zinv[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	secp256k1_fe fscratch[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	secp256k1_scalar sinv[VERIFY_BATCH], sscratch[VERIFY_BATCH];
+	size_t index[VERIFY_BATCH];
+	size_t base, i, n, valid;
+
+	for (base = 0; base < count; base += n) {
+		n = count - base < VERIFY_BATCH ? count - base : VERIFY_BATCH;
+		valid = 0;
+		for (i = 0; i < n; i++) {
+			const size_t j = base + i;
+			if (pub_keys[33 * j] != 0x02 && pub_keys[33 * j] != 0x03) {
+				results[j] = 1;
+			} else if (!ecdsa_read_pubkey(curve, pub_keys + 33 * j, &pub[valid])) {
+				results[j] = 1;
+			} else if ((results[j] = ecdsa_check_sig_range(curve, sigs + 64 * j)) == 0) {
+				secp256k1_scalar_set_b32(&sinv[valid], sigs + 64 * j + 32);
+				index[valid++] = j;
+			}
+		}
+		if (valid == 0) {
+			continue;
+		}
+		point_multiply_table_batch(curve, pub, valid, multiples, qmult, jp, zinv, fscratch);
+		secp256k1_scalar_inverse_batch(sinv, sscratch, valid);
+		for (i = 0; i < valid; i++) {
+			const size_t j = index[i];
+			results[j] = ecdsa_verify_digest_sinv(curve, qmult + i * multiples, VERIFY_WNAF_WINDOW, sigs + 64 * j, digests + 32 * j, &sinv[i]);
+		}
+	}
+	memzero(pub, sizeof(pub));
+	memzero(qmult, sizeof(qmult));
+}
+
+// pub_keys + 33 * i = compressed public key recovered from sigs + 64 * i
+// over digests + 32 * i with recovery id recids[i], for count signatures;
+// results[i] = 0 on success and 1 if there is no such key, as for
+// ecdsa_recover_pub_from_sig. Up to VERIFY_BATCH signatures share the
+// inversions for their R points, for r^-1 and for the affine keys, and
+// each key is s r^-1 R - z r^-1 G with one interleaved multiplication.
+// Runs in variable time.
+void ecdsa_recover_pub_from_sig_batch(const ecdsa_curve *curve, const uint8_t *sigs, const uint8_t *digests, const int *recids, size_t count, uint8_t *pub_keys, int *results)
+{
+	const int multiples = 1 << (VERIFY_WNAF_WINDOW - 2);
+	curve_point R[VERIFY_BATCH];
+	fe_curve_point rmult[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))], pub;
+	jacobian_curve_point jp[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	secp256k1_fe zinv[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	secp256k1_fe fscratch[VERIFY_BATCH * (1 << (VERIFY_WNAF_WINDOW - 2))];
+	secp256k1_scalar rinv[VERIFY_BATCH], sscratch[VERIFY_BATCH], u1, u2;
+	size_t index[VERIFY_BATCH];
+	size_t base, i, n, valid, points;
+
+	assert (bn_is_equal(&curve->order, &secp256k1.order));
+
+	for (base = 0; base < count; base += n) {
+		n = count - base < VERIFY_BATCH ? count - base : VERIFY_BATCH;
+		valid = 0;
+		for (i = 0; i < n; i++) {
+			const size_t j = base + i;
+			results[j] = 1;
+			if (ecdsa_check_sig_range(curve, sigs + 64 * j) != 0) {
+				continue;
+			}
+			// R = k * G (k is secret nonce when signing)
+			bn_read_be(sigs + 64 * j, &R[valid].x);
+			secp256k1_scalar_set_bn(&rinv[valid], &R[valid].x);
+			if (recids[j] & 2) {
+				bn_add(&R[valid].x, &curve->order);
+				if (!bn_is_less(&R[valid].x, &curve->prime)) {
+					continue;
+				}
+			}
+			if (!uncompress_coords_secp256k1(curve, recids[j] & 1, &R[valid].x, &R[valid].y)) {
+				continue;
+			}
+			index[valid++] = j;
+		}
+		if (valid == 0) {
+			continue;
+		}
+		point_multiply_table_batch(curve, R, valid, multiples, rmult, jp, zinv, fscratch);
+		secp256k1_scalar_inverse_batch(rinv, sscratch, valid);
+
+		// pub = r^-1 (s R - z G), in Jacobian coordinates in jp[i]
+		points = 0;
+		for (i = 0; i < valid; i++) {
+			const size_t j = index[i];
+			secp256k1_scalar_set_b32(&u1, digests + 32 * j);
+			secp256k1_scalar_negate(&u1, &u1);
+			secp256k1_scalar_mul(&u1, &u1, &rinv[i]);     // -z*r^-1
+			secp256k1_scalar_set_b32(&u2, sigs + 64 * j + 32);
+			secp256k1_scalar_mul(&u2, &u2, &rinv[i]);     // s*r^-1
+			if (point_multiply_double_var(curve, &u1, &u2, rmult + i * multiples, VERIFY_WNAF_WINDOW, &jp[points])) {
+				zinv[points] = jp[points].z;
+				index[points++] = j;
+			}
+		}
+		secp256k1_fe_inv_batch(zinv, fscratch, points);
+		for (i = 0; i < points; i++) {
+			uint8_t *pub_key = pub_keys + 33 * index[i];
+			bignum256 coordinate;
+
+			jacobian_to_fe_zinv(&jp[i], &zinv[i], &pub);
+			secp256k1_fe_normalize(&pub.y);
+			pub_key[0] = 0x02 | (pub.y.n[0] & 1);
+			secp256k1_fe_get_bn(&coordinate, &pub.x);
+			bn_write_be(&coordinate, pub_key + 1);
+			results[index[i]] = 0;
+		}
+	}
+}
+
+// Decodes and validates pub_key and precomputes its odd multiples for
+// ecdsa_verify_digest_table. Returns 1 on success, 0 for an invalid key.
+int ecdsa_pubkey_table_init(const ecdsa_curve *curve, const uint8_t *pub_key, ecdsa_pubkey_table *table)
+{
+	curve_point pub;
+
+	if (!ecdsa_read_pubkey(curve, pub_key, &pub)) {
+		return 0;
+	}
+	point_multiply_table(curve, &pub, table->multiples, ECDSA_PUBKEY_TABLE_SIZE);
+	memzero(&pub, sizeof(pub));
+	return 1;
+}
+
+// ecdsa_verify_digest for a public key prepared by ecdsa_pubkey_table_init
+int ecdsa_verify_digest_table(const ecdsa_curve *curve, const ecdsa_pubkey_table *table, const uint8_t *sig, const uint8_t *digest)
+{
+	return ecdsa_verify_digest_multiples(curve, table->multiples, ECDSA_PUBKEY_TABLE_WINDOW, sig, digest);
+}
+
 int ecdsa_sig_to_der(const uint8_t *sig, uint8_t *der)
 {
 	int i;
@@ -27,6 +27,8 @@
 #include <stdint.h>
 #include "bignum.h"
 #include "hasher.h"
+#include "secp256k1_field.h"
+#include "rfc6979.h"
 
 #if defined(__cplusplus)
 extern "C"
@@ -38,6 +40,11 @@ typedef struct {
 	bignum256 x, y;
 } curve_point;
 
+// curve point x and y in the secp256k1 field representation
+typedef struct fe_curve_point {
+	secp256k1_fe x, y;
+} fe_curve_point;
+
 typedef struct {
 
 	bignum256 prime;       // prime order of the finite field
@@ -62,6 +69,39 @@ typedef struct {
 #define MAX_WIF_RAW_SIZE (4 + 32 + 1)
 // (4 + 32 + 1 + 4 [checksum]) * 8 / log2(58) plus NUL.
 #define MAX_WIF_SIZE (57)
+// points converted to affine coordinates with a single inversion by the batch functions
+#define SCALAR_MULTIPLY_BATCH 32
+// signed digit width for public keys with a precomputed table
+#define ECDSA_PUBKEY_TABLE_WINDOW 7
+#define ECDSA_PUBKEY_TABLE_SIZE (1 << (ECDSA_PUBKEY_TABLE_WINDOW - 2))
+
+// odd multiples 1, 3, ..., 2 * ECDSA_PUBKEY_TABLE_SIZE - 1 of a public key,
+// for verifying many signatures by the same key
+typedef struct {
+	fe_curve_point multiples[ECDSA_PUBKEY_TABLE_SIZE];
+} ecdsa_pubkey_table;
+
+// Window width in bits of the fixed-base table scalar_multiply uses. The
+// default 4 uses curve->cp; wider windows use the table that tools/mktable
+// generates at build time, see the SECP256K1_COMB_WINDOW CMake option.
+#ifndef SECP256K1_COMB_WINDOW
+#define SECP256K1_COMB_WINDOW 4
+#endif
+#define ECDSA_COMB_MIN_WINDOW 2
+#define ECDSA_COMB_MAX_WINDOW 8
+// number of signed window digits of a 256-bit scalar
+#define ECDSA_COMB_DIGITS(window) ((256 + (window) - 1) / (window))
+// number of points in a table of the given window width
+#define ECDSA_COMB_SIZE(window) (ECDSA_COMB_DIGITS(window) << ((window) - 1))
+
+// Fixed-base table for k * G with window digits of the given width:
+// table[(i << (window - 1)) + j] = (2*j+1) * 2^(window*i) * G. Larger
+// windows take fewer point additions per multiplication at the cost of
+// ECDSA_COMB_SIZE(window) * 64 bytes of table.
+typedef struct {
+	int window;
+	const fe_curve_point *table;
+} ecdsa_comb;
 
 void point_copy(const curve_point *cp1, curve_point *cp2);
 void point_add(const ecdsa_curve *curve, const curve_point *cp1, curve_point *cp2);
@@ -72,13 +112,25 @@ int point_is_infinity(const curve_point *p);
 int point_is_equal(const curve_point *p, const curve_point *q);
 int point_is_negative_of(const curve_point *p, const curve_point *q);
 void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res);
+void scalar_multiply_comb(const ecdsa_curve *curve, const ecdsa_comb *comb, const bignum256 *k, curve_point *res);
+void ecdsa_comb_init(const ecdsa_curve *curve, int window, fe_curve_point *table);
+void scalar_multiply_batch(const ecdsa_curve *curve, const bignum256 *k, curve_point *res, size_t count);
+// Number of scalar multiplications scalar_multiply_batch and
+// ecdsa_sign_digest_batch run in lock step: 4 on CPUs with AVX2, 1
+// otherwise. ecdsa_set_batch_lanes forces 1 or 4, 0 restoring the
+// automatic choice; it returns 0 if the CPU cannot run that many.
+int ecdsa_set_batch_lanes(size_t lanes);
+size_t ecdsa_get_batch_lanes(void);
 int ecdh_multiply(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *pub_key, uint8_t *session_key);
 void uncompress_coords(const ecdsa_curve *curve, uint8_t odd, const bignum256 *x, bignum256 *y);
 int ecdsa_uncompress_pubkey(const ecdsa_curve *curve, const uint8_t *pub_key, uint8_t *uncompressed);
 
 int ecdsa_sign(const ecdsa_curve *curve, HasherType hasher_sign, const uint8_t *priv_key, const uint8_t *msg, uint32_t msg_len, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]));
 int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *digest, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]));
+int ecdsa_sign_digest_key(const ecdsa_curve *curve, const rfc6979_key *key, const uint8_t *digest, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]));
+int ecdsa_sign_digest_batch(const ecdsa_curve *curve, const uint8_t *priv_keys, const uint8_t *digests, size_t count, uint8_t *sigs, uint8_t *pbys);
 void ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key, uint8_t *pub_key);
+void ecdsa_get_public_key33_batch(const ecdsa_curve *curve, const uint8_t *priv_keys, size_t count, uint8_t *pub_keys);
 void ecdsa_get_public_key65(const ecdsa_curve *curve, const uint8_t *priv_key, uint8_t *pub_key);
 void ecdsa_get_pubkeyhash(const uint8_t *pub_key, HasherType hasher_pubkey, uint8_t *pubkeyhash);
 void ecdsa_get_address_raw(const uint8_t *pub_key, uint32_t version, HasherType hasher_pubkey, uint8_t *addr_raw);
@@ -88,7 +140,11 @@ int ecdsa_read_pubkey(const ecdsa_curve *curve, const uint8_t *pub_key, curve_po
 int ecdsa_validate_pubkey(const ecdsa_curve *curve, const curve_point *pub);
 int ecdsa_verify(const ecdsa_curve *curve, HasherType hasher_sign, const uint8_t *pub_key, const uint8_t *sig, const uint8_t *msg, uint32_t msg_len);
 int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key, const uint8_t *sig, const uint8_t *digest);
+void ecdsa_verify_digest_batch(const ecdsa_curve *curve, const uint8_t *pub_keys, const uint8_t *sigs, const uint8_t *digests, size_t count, int *results);
+int ecdsa_pubkey_table_init(const ecdsa_curve *curve, const uint8_t *pub_key, ecdsa_pubkey_table *table);
+int ecdsa_verify_digest_table(const ecdsa_curve *curve, const ecdsa_pubkey_table *table, const uint8_t *sig, const uint8_t *digest);
 int ecdsa_recover_pub_from_sig (const ecdsa_curve *curve, uint8_t *pub_key, const uint8_t *sig, const uint8_t *digest, int recid);
+void ecdsa_recover_pub_from_sig_batch(const ecdsa_curve *curve, const uint8_t *sigs, const uint8_t *digests, const int *recids, size_t count, uint8_t *pub_keys, int *results);
 int ecdsa_sig_to_der(const uint8_t *sig, uint8_t *der);
 
 #ifdef __cplusplus
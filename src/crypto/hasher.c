@@ -72,3 +72,26 @@ void hasher_Raw(HasherType type, const uint8_t *data, size_t length, uint8_t has
 	hasher_Update(&hasher, data, length);
 	hasher_Final(&hasher, hash);
 }
+
+void hasher_Raw_xN(HasherType type, const uint8_t *const data[], const size_t length[], size_t count, uint8_t *const hash[]) {
+	sha256_Raw_xN(data, length, count, hash);
+
+	switch (type) {
+	case HASHER_SHA2:
+		break;
+	case HASHER_SHA2D: {
+		const size_t digestLength[SHA256_MAX_LANES] = {
+			HASHER_DIGEST_LENGTH, HASHER_DIGEST_LENGTH, HASHER_DIGEST_LENGTH, HASHER_DIGEST_LENGTH,
+			HASHER_DIGEST_LENGTH, HASHER_DIGEST_LENGTH, HASHER_DIGEST_LENGTH, HASHER_DIGEST_LENGTH,
+		};
+		for (size_t i = 0; i < count; i += SHA256_MAX_LANES) {
+			const size_t group = count - i < SHA256_MAX_LANES ? count - i : SHA256_MAX_LANES;
+			sha256_Raw_xN((const uint8_t *const *)(hash + i), digestLength, group, hash + i);
+		}
+		break;
+	}
+	case HASHER_SHA2_RIPEMD:
+		ripemd160_32_xN((const uint8_t *const *)hash, count, hash);
+		break;
+	}
+}
@@ -55,6 +55,9 @@ void hasher_Final(Hasher *hasher, uint8_t hash[HASHER_DIGEST_LENGTH]);
 
 void hasher_Raw(HasherType type, const uint8_t *data, size_t length, uint8_t hash[HASHER_DIGEST_LENGTH]);
 
+// Hashes count independent messages like hasher_Raw, using the multi-lane SHA-256.
+void hasher_Raw_xN(HasherType type, const uint8_t *const data[], const size_t length[], size_t count, uint8_t *const hash[]);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "modinv64.h"
+#include "memzero.h"
+
+#if !defined(__SIZEOF_INT128__)
+#error "modinv64 requires __int128"
+#endif
+
+typedef __int128 int128;
+
+#define M62 (UINT64_MAX >> 2)
+
+// 2x2 transition matrix of 59 divsteps, scaled by 2^62
+typedef struct {
+	int64_t u, v, q, r;
+} modinv64_trans2x2;
+
+// Applies 59 divsteps to the low bits f0, g0 of f and g, in constant time.
+// zeta = -(delta + 1/2) carries the divstep state between calls.
+static int64_t modinv64_divsteps_59(int64_t zeta, uint64_t f0, uint64_t g0, modinv64_trans2x2 *t)
+{
+	// the matrix starts at 2^3 and is doubled by each of the 59 steps
+	uint64_t u = 8, v = 0, q = 0, r = 8;
+	volatile uint64_t c1, c2;
+	uint64_t mask1, mask2, f = f0, g = g0, x, y, z;
+	int i;
+
+	for (i = 3; i < 62; i++) {
+		// mask1 = zeta < 0 ? -1 : 0, mask2 = g odd ? -1 : 0
+		c1 = zeta >> 63;
+		mask1 = c1;
+		c2 = g & 1;
+		mask2 = -c2;
+		// x, y, z = zeta < 0 ? (-f, -u, -v) : (f, u, v)
+		x = (f ^ mask1) - mask1;
+		y = (u ^ mask1) - mask1;
+		z = (v ^ mask1) - mask1;
+		// g odd: add x, y, z to g, q, r
+		g += x & mask2;
+		q += y & mask2;
+		r += z & mask2;
+		// when zeta < 0 and g odd, swap: f, u, v += g, q, r and zeta = -zeta - 2
+		mask1 &= mask2;
+		zeta = (zeta ^ (int64_t)mask1) - 1;
+		f += g & mask1;
+		u += q & mask1;
+		v += r & mask1;
+		g >>= 1;
+		u <<= 1;
+		v <<= 1;
+	}
+	t->u = (int64_t)u;
+	t->v = (int64_t)v;
+	t->q = (int64_t)q;
+	t->r = (int64_t)r;
+	return zeta;
+}
+
+// [d, e] = t * [d, e] / 2^62 mod modulus, keeping d and e in (-2 * modulus, modulus)
+static void modinv64_update_de_62(modinv64_signed62 *d, modinv64_signed62 *e, const modinv64_trans2x2 *t, const modinv64_modinfo *modinfo)
+{
+	const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+	int64_t md, me, sd, se;
+	int128 cd, ce;
+	int i;
+
+	// [md, me] start as zero, plus [u, q] if d is negative, plus [v, r] if e is negative
+	sd = d->v[4] >> 63;
+	se = e->v[4] >> 63;
+	md = (u & sd) + (v & se);
+	me = (q & sd) + (r & se);
+	cd = (int128)u * d->v[0] + (int128)v * e->v[0];
+	ce = (int128)q * d->v[0] + (int128)r * e->v[0];
+	// correct md, me so that t * [d, e] + modulus * [md, me] has 62 zero bottom bits
+	md -= (modinfo->modulus_inv62 * (uint64_t)cd + md) & M62;
+	me -= (modinfo->modulus_inv62 * (uint64_t)ce + me) & M62;
+	cd += (int128)modinfo->modulus.v[0] * md;
+	ce += (int128)modinfo->modulus.v[0] * me;
+	cd >>= 62;
+	ce >>= 62;
+	for (i = 1; i < 5; i++) {
+		cd += (int128)u * d->v[i] + (int128)v * e->v[i] + (int128)modinfo->modulus.v[i] * md;
+		ce += (int128)q * d->v[i] + (int128)r * e->v[i] + (int128)modinfo->modulus.v[i] * me;
+		d->v[i - 1] = (int64_t)((uint64_t)cd & M62);
+		e->v[i - 1] = (int64_t)((uint64_t)ce & M62);
+		cd >>= 62;
+		ce >>= 62;
+	}
+	d->v[4] = (int64_t)cd;
+	e->v[4] = (int64_t)ce;
+}
+
+// [f, g] = t * [f, g] / 2^62, which is exact
+static void modinv64_update_fg_62(modinv64_signed62 *f, modinv64_signed62 *g, const modinv64_trans2x2 *t)
+{
+	const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+	int128 cf, cg;
+	int i;
+
+	cf = (int128)u * f->v[0] + (int128)v * g->v[0];
+	cg = (int128)q * f->v[0] + (int128)r * g->v[0];
+	cf >>= 62;
+	cg >>= 62;
+	for (i = 1; i < 5; i++) {
+		cf += (int128)u * f->v[i] + (int128)v * g->v[i];
+		cg += (int128)q * f->v[i] + (int128)r * g->v[i];
+		f->v[i - 1] = (int64_t)((uint64_t)cf & M62);
+		g->v[i - 1] = (int64_t)((uint64_t)cg & M62);
+		cf >>= 62;
+		cg >>= 62;
+	}
+	f->v[4] = (int64_t)cf;
+	g->v[4] = (int64_t)cg;
+}
+
+// r = (sign < 0 ? -r : r) mod modulus, in [0, modulus), for r in (-2 * modulus, modulus)
+static void modinv64_normalize_62(modinv64_signed62 *r, int64_t sign, const modinv64_modinfo *modinfo)
+{
+	volatile int64_t cond_add, cond_negate;
+	int i, k;
+
+	// add the modulus if r is negative, then negate if requested: r in (-modulus, modulus)
+	cond_add = r->v[4] >> 63;
+	cond_negate = sign >> 63;
+	for (i = 0; i < 5; i++) {
+		r->v[i] += modinfo->modulus.v[i] & cond_add;
+		r->v[i] = (r->v[i] ^ cond_negate) - cond_negate;
+	}
+	for (k = 0; k < 2; k++) {
+		// propagate the top bits to bring the limbs back to (-2^62, 2^62)
+		for (i = 0; i < 4; i++) {
+			r->v[i + 1] += r->v[i] >> 62;
+			r->v[i] &= (int64_t)M62;
+		}
+		if (k == 0) {
+			// add the modulus again if r is still negative: r in [0, modulus)
+			cond_add = r->v[4] >> 63;
+			for (i = 0; i < 5; i++) {
+				r->v[i] += modinfo->modulus.v[i] & cond_add;
+			}
+		}
+	}
+}
+
+void modinv64_from_u64(modinv64_signed62 *r, const uint64_t a[4])
+{
+	r->v[0] = (int64_t)(a[0] & M62);
+	r->v[1] = (int64_t)((a[0] >> 62 | a[1] << 2) & M62);
+	r->v[2] = (int64_t)((a[1] >> 60 | a[2] << 4) & M62);
+	r->v[3] = (int64_t)((a[2] >> 58 | a[3] << 6) & M62);
+	r->v[4] = (int64_t)(a[3] >> 56);
+}
+
+void modinv64_to_u64(uint64_t r[4], const modinv64_signed62 *a)
+{
+	const uint64_t v0 = a->v[0], v1 = a->v[1], v2 = a->v[2], v3 = a->v[3], v4 = a->v[4];
+	r[0] = v0 | v1 << 62;
+	r[1] = v1 >> 2 | v2 << 60;
+	r[2] = v2 >> 4 | v3 << 58;
+	r[3] = v3 >> 6 | v4 << 56;
+}
+
+void modinv64_modinfo_init(modinv64_modinfo *modinfo, const uint64_t modulus[4])
+{
+	// Newton iteration: m * m = 1 mod 8, and every step doubles the correct bits
+	uint64_t inv = modulus[0];
+	int i;
+	for (i = 0; i < 5; i++) {
+		inv *= 2 - modulus[0] * inv;
+	}
+	modinv64_from_u64(&modinfo->modulus, modulus);
+	modinfo->modulus_inv62 = inv & M62;
+}
+
+void modinv64(modinv64_signed62 *x, const modinv64_modinfo *modinfo)
+{
+	modinv64_signed62 d = {{0, 0, 0, 0, 0}};
+	modinv64_signed62 e = {{1, 0, 0, 0, 0}};
+	modinv64_signed62 f = modinfo->modulus;
+	modinv64_signed62 g = *x;
+	modinv64_trans2x2 t;
+	int64_t zeta = -1; // zeta = -(delta + 1/2), delta starts at 1/2
+	int i;
+
+	// 10 rounds of 59 divsteps: 590 steps suffice for 256-bit inputs
+	for (i = 0; i < 10; i++) {
+		zeta = modinv64_divsteps_59(zeta, f.v[0], g.v[0], &t);
+		modinv64_update_de_62(&d, &e, &t, modinfo);
+		modinv64_update_fg_62(&f, &g, &t);
+	}
+	// g = 0 and f = +-1 now, with d = f * x^-1
+	modinv64_normalize_62(&d, f.v[4], modinfo);
+	*x = d;
+	memzero(&e, sizeof(e));
+	memzero(&f, sizeof(f));
+	memzero(&g, sizeof(g));
+	memzero(&t, sizeof(t));
+}
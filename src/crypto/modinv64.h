@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __MODINV64_H__
+#define __MODINV64_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Constant-time modular inversion with the safegcd algorithm of Bernstein
+// and Yang ("Fast constant-time gcd computation and modular inversion",
+// 2019), following the divstep variant of libsecp256k1.
+
+// A signed number sum(v[i] * 2^(62*i)), normally with v[0..3] in [0, 2^62).
+typedef struct {
+	int64_t v[5];
+} modinv64_signed62;
+
+typedef struct {
+	// the odd modulus, below 2^256
+	modinv64_signed62 modulus;
+	// modulus^-1 mod 2^62
+	uint64_t modulus_inv62;
+} modinv64_modinfo;
+
+// Prepares the modinfo for an odd modulus of four little-endian 64-bit limbs
+void modinv64_modinfo_init(modinv64_modinfo *modinfo, const uint64_t modulus[4]);
+
+// r = a for a number of four little-endian 64-bit limbs
+void modinv64_from_u64(modinv64_signed62 *r, const uint64_t a[4]);
+
+// r = a for a number in [0, 2^256)
+void modinv64_to_u64(uint64_t r[4], const modinv64_signed62 *a);
+
+// x = x^-1 mod modulus for 0 <= x < modulus, or 0 if x = 0.
+// The modulus must be prime or x coprime to it. The timing does not depend on x.
+void modinv64(modinv64_signed62 *x, const modinv64_modinfo *modinfo);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -22,20 +22,169 @@
  */
 
 #include "rand.h"
+#include "memzero.h"
 
-#include <pcg_random.hpp>
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
 #include <random>
 
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+namespace {
+
+/// Incremented in the child after every fork, so that generators copied from the parent reseed.
+std::atomic<unsigned> forkCount{0};
+
+const int atforkRegistered = pthread_atfork(nullptr, nullptr, [] { forkCount.fetch_add(1, std::memory_order_relaxed); });
+
+/// Fills a buffer with entropy from the operating system.
+void systemRandom(uint8_t *buf, size_t len) {
+#if defined(__linux__)
+    while (len > 0) {
+        const auto count = getrandom(buf, len, 0);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        buf += count;
+        len -= count;
+    }
+#endif
+    if (len > 0) {
+        std::random_device device;
+        while (len > 0) {
+            const uint32_t value = device();
+            const auto count = std::min(len, sizeof(value));
+            std::memcpy(buf, &value, count);
+            buf += count;
+            len -= count;
+        }
+    }
+}
+
+inline uint32_t rotate(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+inline void quarterRound(uint32_t *x, int a, int b, int c, int d) {
+    x[a] += x[b]; x[d] = rotate(x[d] ^ x[a], 16);
+    x[c] += x[d]; x[b] = rotate(x[b] ^ x[c], 12);
+    x[a] += x[b]; x[d] = rotate(x[d] ^ x[a], 8);
+    x[c] += x[d]; x[b] = rotate(x[b] ^ x[c], 7);
+}
+
+/// Writes the 64-byte ChaCha20 block `counter` of `key` with an all-zero nonce.
+void chacha20Block(const uint32_t key[8], uint64_t counter, uint8_t *out) {
+    uint32_t input[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+    std::copy(key, key + 8, input + 4);
+    input[12] = static_cast<uint32_t>(counter);
+    input[13] = static_cast<uint32_t>(counter >> 32);
+
+    uint32_t x[16];
+    std::copy(input, input + 16, x);
+    for (auto i = 0; i < 10; i += 1) {
+        quarterRound(x, 0, 4, 8, 12);
+        quarterRound(x, 1, 5, 9, 13);
+        quarterRound(x, 2, 6, 10, 14);
+        quarterRound(x, 3, 7, 11, 15);
+        quarterRound(x, 0, 5, 10, 15);
+        quarterRound(x, 1, 6, 11, 12);
+        quarterRound(x, 2, 7, 8, 13);
+        quarterRound(x, 3, 4, 9, 14);
+    }
+    for (auto i = 0; i < 16; i += 1) {
+        const auto word = x[i] + input[i];
+        out[4 * i] = static_cast<uint8_t>(word);
+        out[4 * i + 1] = static_cast<uint8_t>(word >> 8);
+        out[4 * i + 2] = static_cast<uint8_t>(word >> 16);
+        out[4 * i + 3] = static_cast<uint8_t>(word >> 24);
+    }
+    memzero(x, sizeof(x));
+    memzero(input, sizeof(input));
+}
+
+/// ChaCha20 generator with fast key erasure.
+///
+/// Every refill generates a buffer of keystream, replaces the key with its first 32 bytes and hands
+/// out the rest, so earlier output cannot be recovered from the state. The key is reseeded from the
+/// operating system after `reseedInterval` bytes and in the child after a fork.
+class Generator {
+public:
+    ~Generator() {
+        memzero(key, sizeof(key));
+        memzero(buffer, sizeof(buffer));
+    }
+
+    void generate(uint8_t *out, size_t len) {
+        if (!seeded || forks != forkCount.load(std::memory_order_relaxed) || sinceReseed >= reseedInterval) {
+            reseed();
+        }
+        sinceReseed += len;
+        while (len > 0) {
+            if (position == sizeof(buffer)) {
+                refill();
+            }
+            const auto count = std::min(len, sizeof(buffer) - position);
+            std::memcpy(out, buffer + position, count);
+            memzero(buffer + position, count);
+            position += count;
+            out += count;
+            len -= count;
+        }
+    }
+
+private:
+    static constexpr size_t reseedInterval = 1 << 20;
+    static constexpr size_t blocks = 8;
+
+    void reseed() {
+        uint8_t seed[sizeof(key)];
+        systemRandom(seed, sizeof(seed));
+        std::memcpy(key, seed, sizeof(key));
+        memzero(seed, sizeof(seed));
+        // Discards output buffered before a fork, which the parent hands out as well
+        memzero(buffer, sizeof(buffer));
+        position = sizeof(buffer);
+        forks = forkCount.load(std::memory_order_relaxed);
+        sinceReseed = 0;
+        seeded = true;
+    }
+
+    void refill() {
+        for (size_t i = 0; i < blocks; i += 1) {
+            chacha20Block(key, i, buffer + 64 * i);
+        }
+        std::memcpy(key, buffer, sizeof(key));
+        memzero(buffer, sizeof(key));
+        position = sizeof(key);
+    }
+
+    uint32_t key[8];
+    uint8_t buffer[64 * blocks];
+    size_t position = sizeof(buffer);
+    size_t sinceReseed = 0;
+    unsigned forks = 0;
+    bool seeded = false;
+};
+
+thread_local Generator generator;
+
+} // namespace
+
 uint32_t __attribute__((weak)) random32() {
-    pcg_extras::seed_seq_from<std::random_device> seed_source;
-    pcg32 rng(seed_source);
-    return rng();
+    uint32_t value;
+    generator.generate(reinterpret_cast<uint8_t *>(&value), sizeof(value));
+    return value;
 }
 
 void __attribute__((weak)) random_buffer(uint8_t *buf, size_t len) {
-    pcg_extras::seed_seq_from<std::random_device> seed_source;
-    pcg32 rng(seed_source);
-    for (auto i = 0; i < len; i += 1) {
-        buf[i] = rng();
-    }
+    generator.generate(buf, len);
 }
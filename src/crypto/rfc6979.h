@@ -28,13 +28,33 @@
 #include <stdint.h>
 #include "bignum.h"
 
-// rfc6979 pseudo random number generator state
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// rfc6979 pseudo random number generator state, with the HMAC pad digests
+// of k from hmac_sha256_prepare
 typedef struct {
 	uint8_t v[32], k[32];
+	uint32_t opad[8], ipad[8];
 } rfc6979_state;
 
+// the part of the rfc6979 initialization that depends only on the private
+// key, for signing many digests with one key
+typedef struct {
+	uint8_t priv_key[32];
+	uint32_t opad[8];  // outer pad digest of the initial all-zero k
+	uint32_t inner[8]; // inner hash after the pad and v || 0x00 || priv_key[0..30]
+} rfc6979_key;
+
+void init_rfc6979_key(const uint8_t *priv_key, rfc6979_key *key);
 void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash, rfc6979_state *rng);
+void init_rfc6979_with_key(const rfc6979_key *key, const uint8_t *hash, rfc6979_state *rng);
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *rng);
 void generate_k_rfc6979(bignum256 *k, rfc6979_state *rng);
 
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif
@@ -341,3 +341,211 @@ void ripemd160(const uint8_t *msg, uint32_t msg_len, uint8_t hash[RIPEMD160_DIGE
     ripemd160_Update( &ctx, msg, msg_len );
     ripemd160_Final( &ctx, hash );
 }
+
+/*
+ * Multi-lane RIPEMD-160 of 32-byte messages
+ *
+ * Key hashes are RIPEMD-160 of a SHA-256 digest, so the input is always
+ * a single block: 32 message bytes, the 0x80 pad byte and a bit length of
+ * 256. Lanes are word-sliced like the multi-buffer SHA-256, one message per
+ * vector lane, and the rounds reuse F1..F5 and S on GCC vector types.
+ */
+#if !defined(RIPEMD160_NO_ACCELERATION) && ( defined(__x86_64__) || defined(__i386__) ) && defined(__GNUC__)
+#define RIPEMD160_MULTI_BUFFER
+#endif
+
+#if defined(RIPEMD160_MULTI_BUFFER)
+
+#include "sha2.h"
+
+typedef uint32_t ripemd160_word32x4 __attribute__((vector_size(16)));
+typedef uint32_t ripemd160_word32x8 __attribute__((vector_size(32)));
+
+static const uint8_t ripemd160_rl[80] = {
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+     7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+     3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+     1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+     4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13
+};
+
+static const uint8_t ripemd160_rr[80] = {
+     5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+     6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+    15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+     8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+    12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11
+};
+
+static const uint8_t ripemd160_sl[80] = {
+    11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+     7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+    11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+    11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+     9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6
+};
+
+static const uint8_t ripemd160_sr[80] = {
+     8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+     9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+     9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+    15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+     8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11
+};
+
+/* Unrolling turns the table lookups and rotations into immediates */
+#if defined(__clang__)
+#define RIPEMD160_UNROLL    _Pragma( "unroll" )
+#else
+#define RIPEMD160_UNROLL    _Pragma( "GCC unroll 16" )
+#endif
+
+/* One group of 16 steps on both lines, with fixed functions and constants */
+#define RIPEMD160_STEPS( first, f, k, fp, kp )                                  \
+    RIPEMD160_UNROLL                                                            \
+    for( j = first; j < first + 16; j++ )                                       \
+    {                                                                           \
+        T = A + f( B, C, D ) + X[ripemd160_rl[j]] + k;                          \
+        T = S( T, ripemd160_sl[j] ) + E;                                        \
+        A = E; E = D; D = S( C, 10 ); C = B; B = T;                             \
+        T = Ap + fp( Bp, Cp, Dp ) + X[ripemd160_rr[j]] + kp;                    \
+        T = S( T, ripemd160_sr[j] ) + Ep;                                       \
+        Ap = Ep; Ep = Dp; Dp = S( Cp, 10 ); Cp = Bp; Bp = T;                    \
+    }
+
+/*
+ * Defines a function hashing `lanes` 32-byte messages; msg and hash hold
+ * one pointer per lane.
+ */
+#define RIPEMD160_32_XN( name, vector, lanes, isa )                             \
+__attribute__((target(isa)))                                                    \
+static void name( const uint8_t *const msg[], uint8_t *const hash[] )           \
+{                                                                               \
+    uint32_t words[16 * (lanes)], out[5 * (lanes)];                             \
+    vector A, B, C, D, E, Ap, Bp, Cp, Dp, Ep, T, X[16], H[5], zero = { 0 };     \
+    int i, l, j;                                                                \
+                                                                                \
+    for( l = 0; l < (lanes); l++ )                                              \
+        for( i = 0; i < 8; i++ )                                                \
+            GET_UINT32_LE( words[i * (lanes) + l], msg[l], 4 * i );             \
+    for( i = 0; i < 8; i++ )                                                    \
+        memcpy( &X[i], &words[i * (lanes)], sizeof( vector ) );                 \
+    for( i = 8; i < 16; i++ )                                                   \
+        X[i] = zero;                                                            \
+    X[8] += 0x80;                                                               \
+    X[14] += 256;                                                               \
+                                                                                \
+    A = Ap = zero + 0x67452301;                                                 \
+    B = Bp = zero + 0xEFCDAB89;                                                 \
+    C = Cp = zero + 0x98BADCFE;                                                 \
+    D = Dp = zero + 0x10325476;                                                 \
+    E = Ep = zero + 0xC3D2E1F0;                                                 \
+                                                                                \
+    RIPEMD160_STEPS(  0, F1, 0x00000000, F5, 0x50A28BE6 )                       \
+    RIPEMD160_STEPS( 16, F2, 0x5A827999, F4, 0x5C4DD124 )                       \
+    RIPEMD160_STEPS( 32, F3, 0x6ED9EBA1, F3, 0x6D703EF3 )                       \
+    RIPEMD160_STEPS( 48, F4, 0x8F1BBCDC, F2, 0x7A6D76E9 )                       \
+    RIPEMD160_STEPS( 64, F5, 0xA953FD4E, F1, 0x00000000 )                       \
+                                                                                \
+    H[0] = C + Dp + 0xEFCDAB89;                                                 \
+    H[1] = D + Ep + 0x98BADCFE;                                                 \
+    H[2] = E + Ap + 0x10325476;                                                 \
+    H[3] = A + Bp + 0xC3D2E1F0;                                                 \
+    H[4] = B + Cp + 0x67452301;                                                 \
+    for( i = 0; i < 5; i++ )                                                    \
+        memcpy( &out[i * (lanes)], &H[i], sizeof( vector ) );                   \
+    for( l = 0; l < (lanes); l++ )                                              \
+        for( i = 0; i < 5; i++ )                                                \
+            PUT_UINT32_LE( out[i * (lanes) + l], hash[l], 4 * i );              \
+                                                                                \
+    memzero( words, sizeof( words ) );                                          \
+    memzero( out, sizeof( out ) );                                              \
+}
+
+RIPEMD160_32_XN( ripemd160_32_x4_sse2, ripemd160_word32x4, 4, "sse2" )
+RIPEMD160_32_XN( ripemd160_32_x8_avx2, ripemd160_word32x8, 8, "avx2" )
+
+#endif /* RIPEMD160_MULTI_BUFFER */
+
+/* Lane count requested with ripemd160_set_lanes, 0 meaning automatic. */
+static size_t ripemd160_requested_lanes = 0;
+
+#if defined(__GNUC__)
+#define RIPEMD160_LOAD_RELAXED(p)       __atomic_load_n( (p), __ATOMIC_RELAXED )
+#define RIPEMD160_STORE_RELAXED(p,v)    __atomic_store_n( (p), (v), __ATOMIC_RELAXED )
+#else
+#define RIPEMD160_LOAD_RELAXED(p)       ( *(p) )
+#define RIPEMD160_STORE_RELAXED(p,v)    ( *(p) = (v) )
+#endif
+
+#if defined(RIPEMD160_MULTI_BUFFER)
+/*
+ * Whether the eight-lane AVX2 code can run, or -1 until the first call
+ * probes the CPU, so that each batch does not run CPUID and xgetbv again.
+ */
+static int ripemd160_avx2_supported = -1;
+
+static int ripemd160_has_avx2( void )
+{
+    int supported = RIPEMD160_LOAD_RELAXED( &ripemd160_avx2_supported );
+
+    if( supported < 0 )
+    {
+        /* The SHA-256 AVX2 backend has the same CPU and OS requirements */
+        supported = sha256_backend_supported( SHA256_BACKEND_AVX2 );
+        RIPEMD160_STORE_RELAXED( &ripemd160_avx2_supported, supported );
+    }
+    return( supported );
+}
+#endif
+
+int ripemd160_set_lanes( size_t lanes )
+{
+    switch( lanes )
+    {
+    case 0:
+    case 1:
+        break;
+#if defined(RIPEMD160_MULTI_BUFFER)
+    case 4:
+        break;
+    case 8:
+        if( !ripemd160_has_avx2() )
+            return( 0 );
+        break;
+#endif
+    default:
+        return( 0 );
+    }
+    RIPEMD160_STORE_RELAXED( &ripemd160_requested_lanes, lanes );
+    return( 1 );
+}
+
+size_t ripemd160_get_lanes( void )
+{
+    size_t lanes = RIPEMD160_LOAD_RELAXED( &ripemd160_requested_lanes );
+
+    if( lanes != 0 )
+        return( lanes );
+#if defined(RIPEMD160_MULTI_BUFFER)
+    return( ripemd160_has_avx2() ? 8 : 4 );
+#else
+    return( 1 );
+#endif
+}
+
+void ripemd160_32_xN( const uint8_t *const msg[], size_t count, uint8_t *const hash[] )
+{
+    size_t lanes = ripemd160_get_lanes(), i = 0;
+
+#if defined(RIPEMD160_MULTI_BUFFER)
+    for( ; lanes == 8 && count - i >= 8; i += 8 )
+        ripemd160_32_x8_avx2( msg + i, hash + i );
+    for( ; lanes >= 4 && count - i >= 4; i += 4 )
+        ripemd160_32_x4_sse2( msg + i, hash + i );
+#else
+    (void) lanes;
+#endif
+    for( ; i < count; i++ )
+        ripemd160( msg[i], 32, hash[i] );
+}
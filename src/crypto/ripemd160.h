@@ -1,6 +1,7 @@
 #ifndef __RIPEMD160_H__
 #define __RIPEMD160_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -21,6 +22,15 @@ void ripemd160_Update(RIPEMD160_CTX *ctx, const uint8_t *input, uint32_t ilen);
 void ripemd160_Final(RIPEMD160_CTX *ctx, uint8_t output[RIPEMD160_DIGEST_LENGTH]);
 void ripemd160(const uint8_t *msg, uint32_t msg_len, uint8_t hash[RIPEMD160_DIGEST_LENGTH]);
 
+/*
+ * Hashes count 32-byte messages, msg[i] into hash[i], 4 (SSE2) or 8 (AVX2)
+ * at a time. ripemd160_set_lanes forces 1, 4 or 8 lanes, 0 restoring the
+ * automatic choice; it returns 0 if the CPU cannot run that many.
+ */
+void ripemd160_32_xN(const uint8_t *const msg[], size_t count, uint8_t *const hash[]);
+int ripemd160_set_lanes(size_t lanes);
+size_t ripemd160_get_lanes(void);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -53,6 +53,17 @@ const ecdsa_curve secp256k1 = {
 	}
 };
 
+#if SECP256K1_COMB_WINDOW != 4
+static const fe_curve_point secp256k1_comb_table[ECDSA_COMB_SIZE(SECP256K1_COMB_WINDOW)] = {
+#include "secp256k1_comb.table"
+};
+
+const ecdsa_comb secp256k1_comb = {
+	SECP256K1_COMB_WINDOW,
+	secp256k1_comb_table,
+};
+#endif
+
 const curve_info secp256k1_info = {
 	.bip32_name = "Bitcoin seed",
 	.params = &secp256k1,
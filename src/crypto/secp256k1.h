@@ -43,6 +43,10 @@ typedef struct {
 } curve_info;
 
 extern const ecdsa_curve secp256k1;
+#if SECP256K1_COMB_WINDOW != 4
+// generated fixed-base table with SECP256K1_COMB_WINDOW bit windows
+extern const ecdsa_comb secp256k1_comb;
+#endif
 extern const curve_info secp256k1_info;
 extern const curve_info secp256k1_decred_info;
 extern const curve_info secp256k1_groestl_info;
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "secp256k1_field.h"
+#include "modinv64.h"
+#include "memzero.h"
+
+// p = 2^256 - 2^32 - 977
+static const modinv64_modinfo secp256k1_fe_modinfo = {
+	{{0x3FFFFFFEFFFFFC2FLL, 0x3FFFFFFFFFFFFFFFLL, 0x3FFFFFFFFFFFFFFFLL, 0x3FFFFFFFFFFFFFFFLL, 0xFF}},
+	0x27C7F6E22DDACACFULL,
+};
+
+void secp256k1_fe_inv(secp256k1_fe *r, const secp256k1_fe *a)
+{
+	secp256k1_fe t = *a;
+	modinv64_signed62 x;
+
+	secp256k1_fe_normalize(&t);
+	modinv64_from_u64(&x, t.n);
+	modinv64(&x, &secp256k1_fe_modinfo);
+	modinv64_to_u64(r->n, &x);
+	memzero(&t, sizeof(t));
+	memzero(&x, sizeof(x));
+}
+
+// r = a^(2^n)
+static void secp256k1_fe_sqr_n(secp256k1_fe *r, const secp256k1_fe *a, int n)
+{
+	int i;
+
+	*r = *a;
+	for (i = 0; i < n; i++) {
+		secp256k1_fe_sqr(r, r);
+	}
+}
+
+// The exponents (p+1)/4 and p-2 share their leading 223 one bits. Returns
+// x223 = a^(2^223 - 1) and the x2 and x22 it is built from, where
+// xk = a^(2^k - 1), with 222 squarings and 11 multiplications.
+static void secp256k1_fe_pow_x223(secp256k1_fe *x223, secp256k1_fe *x22, secp256k1_fe *x2, const secp256k1_fe *a)
+{
+	secp256k1_fe x3, x6, x11, x44, x88, t;
+
+	secp256k1_fe_sqr(x2, a);
+	secp256k1_fe_mul(x2, x2, a);
+	secp256k1_fe_sqr(&x3, x2);
+	secp256k1_fe_mul(&x3, &x3, a);
+	secp256k1_fe_sqr_n(&x6, &x3, 3);
+	secp256k1_fe_mul(&x6, &x6, &x3);
+	secp256k1_fe_sqr_n(&t, &x6, 3);
+	secp256k1_fe_mul(&t, &t, &x3);                // x9
+	secp256k1_fe_sqr_n(&x11, &t, 2);
+	secp256k1_fe_mul(&x11, &x11, x2);
+	secp256k1_fe_sqr_n(x22, &x11, 11);
+	secp256k1_fe_mul(x22, x22, &x11);
+	secp256k1_fe_sqr_n(&x44, x22, 22);
+	secp256k1_fe_mul(&x44, &x44, x22);
+	secp256k1_fe_sqr_n(&x88, &x44, 44);
+	secp256k1_fe_mul(&x88, &x88, &x44);
+	secp256k1_fe_sqr_n(&t, &x88, 88);
+	secp256k1_fe_mul(&t, &t, &x88);               // x176
+	secp256k1_fe_sqr_n(&t, &t, 44);
+	secp256k1_fe_mul(&t, &t, &x44);               // x220
+	secp256k1_fe_sqr_n(x223, &t, 3);
+	secp256k1_fe_mul(x223, x223, &x3);
+	memzero(&x3, sizeof(x3));
+	memzero(&x6, sizeof(x6));
+	memzero(&x11, sizeof(x11));
+	memzero(&x44, sizeof(x44));
+	memzero(&x88, sizeof(x88));
+	memzero(&t, sizeof(t));
+}
+
+void secp256k1_fe_inv_pow(secp256k1_fe *r, const secp256k1_fe *a)
+{
+	secp256k1_fe x223, x22, x2;
+
+	// p - 2 = [223 ones] 0 [22 ones] 0000 1 0 11 0 1
+	secp256k1_fe_pow_x223(&x223, &x22, &x2, a);
+	secp256k1_fe_sqr_n(r, &x223, 23);
+	secp256k1_fe_mul(r, r, &x22);
+	secp256k1_fe_sqr_n(r, r, 5);
+	secp256k1_fe_mul(r, r, a);
+	secp256k1_fe_sqr_n(r, r, 3);
+	secp256k1_fe_mul(r, r, &x2);
+	secp256k1_fe_sqr_n(r, r, 2);
+	secp256k1_fe_mul(r, r, a);
+	memzero(&x223, sizeof(x223));
+	memzero(&x22, sizeof(x22));
+	memzero(&x2, sizeof(x2));
+}
+
+int secp256k1_fe_sqrt(secp256k1_fe *r, const secp256k1_fe *a)
+{
+	secp256k1_fe x223, x22, x2, check, t = *a;
+
+	// (p + 1) / 4 = [223 ones] 0 [22 ones] 0000 11 00
+	secp256k1_fe_pow_x223(&x223, &x22, &x2, &t);
+	secp256k1_fe_sqr_n(r, &x223, 23);
+	secp256k1_fe_mul(r, r, &x22);
+	secp256k1_fe_sqr_n(r, r, 6);
+	secp256k1_fe_mul(r, r, &x2);
+	secp256k1_fe_sqr_n(r, r, 2);
+
+	secp256k1_fe_sqr(&check, r);
+	secp256k1_fe_sub(&check, &check, &t);
+	memzero(&x223, sizeof(x223));
+	memzero(&x22, sizeof(x22));
+	memzero(&x2, sizeof(x2));
+	memzero(&t, sizeof(t));
+	return secp256k1_fe_is_zero(&check);
+}
+
+void secp256k1_fe_inv_batch(secp256k1_fe *x, secp256k1_fe *scratch, size_t count)
+{
+	secp256k1_fe inv, tmp;
+	size_t i;
+
+	if (count == 0) {
+		return;
+	}
+	// scratch[i] = x[0] * ... * x[i]
+	scratch[0] = x[0];
+	for (i = 1; i < count; i++) {
+		secp256k1_fe_mul(&scratch[i], &scratch[i - 1], &x[i]);
+	}
+	secp256k1_fe_inv(&inv, &scratch[count - 1]);
+	for (i = count - 1; i > 0; i--) {
+		// invariant: inv = (x[0] * ... * x[i])^-1
+		secp256k1_fe_mul(&tmp, &inv, &scratch[i - 1]);
+		secp256k1_fe_mul(&inv, &inv, &x[i]);
+		x[i] = tmp;
+	}
+	x[0] = inv;
+	memzero(&inv, sizeof(inv));
+	memzero(&tmp, sizeof(tmp));
+	memzero(scratch, count * sizeof(secp256k1_fe));
+}
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __SECP256K1_FIELD_H__
+#define __SECP256K1_FIELD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bignum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(__SIZEOF_INT128__)
+#error "secp256k1 field arithmetic requires unsigned __int128"
+#endif
+
+typedef unsigned __int128 secp256k1_uint128;
+
+// Element of the secp256k1 field, p = 2^256 - 2^32 - 977, as four 64-bit
+// little-endian limbs.
+//
+// Results of the arithmetic below are only weakly reduced: any value below
+// 2^256 is accepted and returned, so p itself and values slightly above it
+// appear. secp256k1_fe_normalize brings an element to [0, p).
+typedef struct {
+	uint64_t n[4];
+} secp256k1_fe;
+
+// 2^256 mod p
+#define SECP256K1_FE_C 0x1000003D1ULL
+
+// p, limb 0; the other limbs are all ones
+#define SECP256K1_FE_P0 0xFFFFFFFEFFFFFC2FULL
+
+// r = a from a normalized bignum (a < 2^256)
+static inline void secp256k1_fe_set_bn(secp256k1_fe *r, const bignum256 *a) {
+	const uint32_t *v = a->val;
+	r->n[0] = (uint64_t)v[0] | (uint64_t)v[1] << 30 | (uint64_t)v[2] << 60;
+	r->n[1] = (uint64_t)v[2] >> 4 | (uint64_t)v[3] << 26 | (uint64_t)v[4] << 56;
+	r->n[2] = (uint64_t)v[4] >> 8 | (uint64_t)v[5] << 22 | (uint64_t)v[6] << 52;
+	r->n[3] = (uint64_t)v[6] >> 12 | (uint64_t)v[7] << 18 | (uint64_t)v[8] << 48;
+}
+
+// r = r mod p, in [0, p)
+static inline void secp256k1_fe_normalize(secp256k1_fe *r) {
+	// r >= p iff r + (2^256 - p) overflows, and then the wrapped sum is r - p
+	secp256k1_uint128 t = (secp256k1_uint128)r->n[0] + SECP256K1_FE_C;
+	uint64_t s[4], mask;
+	int i;
+	s[0] = (uint64_t)t;
+	for (i = 1; i < 4; i++) {
+		t = (t >> 64) + r->n[i];
+		s[i] = (uint64_t)t;
+	}
+	mask = -(uint64_t)(t >> 64);
+	for (i = 0; i < 4; i++) {
+		r->n[i] = (s[i] & mask) | (r->n[i] & ~mask);
+	}
+}
+
+// r = a as a normalized bignum
+static inline void secp256k1_fe_get_bn(bignum256 *r, const secp256k1_fe *a) {
+	secp256k1_fe t = *a;
+	secp256k1_fe_normalize(&t);
+	r->val[0] = t.n[0] & 0x3FFFFFFF;
+	r->val[1] = (t.n[0] >> 30) & 0x3FFFFFFF;
+	r->val[2] = (t.n[0] >> 60 | t.n[1] << 4) & 0x3FFFFFFF;
+	r->val[3] = (t.n[1] >> 26) & 0x3FFFFFFF;
+	r->val[4] = (t.n[1] >> 56 | t.n[2] << 8) & 0x3FFFFFFF;
+	r->val[5] = (t.n[2] >> 22) & 0x3FFFFFFF;
+	r->val[6] = (t.n[2] >> 52 | t.n[3] << 12) & 0x3FFFFFFF;
+	r->val[7] = (t.n[3] >> 18) & 0x3FFFFFFF;
+	r->val[8] = t.n[3] >> 48;
+}
+
+// r = r + c * 2^256 mod p, for c < 2^64
+static inline void secp256k1_fe_fold(secp256k1_fe *r, uint64_t c) {
+	secp256k1_uint128 t = (secp256k1_uint128)c * SECP256K1_FE_C + r->n[0];
+	int i;
+	r->n[0] = (uint64_t)t;
+	for (i = 1; i < 4; i++) {
+		t = (t >> 64) + r->n[i];
+		r->n[i] = (uint64_t)t;
+	}
+	// on overflow the wrapped value is below 2^97, so this carry stops at limb 1
+	t = (t >> 64) * SECP256K1_FE_C + r->n[0];
+	r->n[0] = (uint64_t)t;
+	r->n[1] += (uint64_t)(t >> 64);
+}
+
+// r = l mod p for a 512-bit l
+static inline void secp256k1_fe_reduce(secp256k1_fe *r, const uint64_t l[8]) {
+	// 2^256 = C (mod p): r = l[0..3] + l[4..7] * C, then fold the top carry
+	secp256k1_uint128 t = 0;
+	int i;
+	for (i = 0; i < 4; i++) {
+		t += (secp256k1_uint128)l[i + 4] * SECP256K1_FE_C + l[i];
+		r->n[i] = (uint64_t)t;
+		t >>= 64;
+	}
+	secp256k1_fe_fold(r, (uint64_t)t);
+}
+
+// r = a * b
+static inline void secp256k1_fe_mul(secp256k1_fe *r, const secp256k1_fe *a, const secp256k1_fe *b) {
+	// column by column: acc + (top << 128) holds the sum of column k
+	uint64_t l[8], top = 0;
+	secp256k1_uint128 acc = 0, t;
+	int i, k;
+	for (k = 0; k < 7; k++) {
+		for (i = k < 4 ? 0 : k - 3; i <= k && i < 4; i++) {
+			t = (secp256k1_uint128)a->n[i] * b->n[k - i];
+			acc += t;
+			top += acc < t;
+		}
+		l[k] = (uint64_t)acc;
+		acc = (acc >> 64) | (secp256k1_uint128)top << 64;
+		top = 0;
+	}
+	l[7] = (uint64_t)acc;
+	secp256k1_fe_reduce(r, l);
+}
+
+// r = a^2, with each cross product computed once
+static inline void secp256k1_fe_sqr(secp256k1_fe *r, const secp256k1_fe *a) {
+	// column by column: acc + (top << 128) holds the sum of column k
+	uint64_t l[8], top = 0;
+	secp256k1_uint128 acc = 0, t;
+	int i, k;
+	for (k = 0; k < 7; k++) {
+		for (i = k < 4 ? 0 : k - 3; 2 * i < k; i++) {
+			t = (secp256k1_uint128)a->n[i] * a->n[k - i];
+			acc += t;
+			top += acc < t;
+			acc += t;
+			top += acc < t;
+		}
+		if ((k & 1) == 0) {
+			t = (secp256k1_uint128)a->n[k / 2] * a->n[k / 2];
+			acc += t;
+			top += acc < t;
+		}
+		l[k] = (uint64_t)acc;
+		acc = (acc >> 64) | (secp256k1_uint128)top << 64;
+		top = 0;
+	}
+	l[7] = (uint64_t)acc;
+	secp256k1_fe_reduce(r, l);
+}
+
+// r = a + b
+static inline void secp256k1_fe_add(secp256k1_fe *r, const secp256k1_fe *a, const secp256k1_fe *b) {
+	secp256k1_uint128 t = 0;
+	int i;
+	for (i = 0; i < 4; i++) {
+		t += (secp256k1_uint128)a->n[i] + b->n[i];
+		r->n[i] = (uint64_t)t;
+		t >>= 64;
+	}
+	secp256k1_fe_fold(r, (uint64_t)t);
+}
+
+// r = a - b
+static inline void secp256k1_fe_sub(secp256k1_fe *r, const secp256k1_fe *a, const secp256k1_fe *b) {
+	secp256k1_uint128 t;
+	uint64_t borrow = 0;
+	int i, k;
+	for (i = 0; i < 4; i++) {
+		t = (secp256k1_uint128)a->n[i] - b->n[i] - borrow;
+		r->n[i] = (uint64_t)t;
+		borrow = (uint64_t)(t >> 64) & 1;
+	}
+	// a wrapped difference is 2^256 = C too large; subtracting C may wrap once more
+	for (k = 0; k < 2; k++) {
+		t = (secp256k1_uint128)r->n[0] - (borrow * SECP256K1_FE_C);
+		r->n[0] = (uint64_t)t;
+		borrow = (uint64_t)(t >> 64) & 1;
+		for (i = 1; i < 4; i++) {
+			t = (secp256k1_uint128)r->n[i] - borrow;
+			r->n[i] = (uint64_t)t;
+			borrow = (uint64_t)(t >> 64) & 1;
+		}
+	}
+}
+
+// r = -a
+static inline void secp256k1_fe_negate(secp256k1_fe *r, const secp256k1_fe *a) {
+	const secp256k1_fe zero = {{0, 0, 0, 0}};
+	secp256k1_fe_sub(r, &zero, a);
+}
+
+// r = a * k for a small k
+static inline void secp256k1_fe_mul_int(secp256k1_fe *r, const secp256k1_fe *a, uint32_t k) {
+	secp256k1_uint128 t = 0;
+	int i;
+	for (i = 0; i < 4; i++) {
+		t += (secp256k1_uint128)a->n[i] * k;
+		r->n[i] = (uint64_t)t;
+		t >>= 64;
+	}
+	secp256k1_fe_fold(r, (uint64_t)t);
+}
+
+// r = a / 2
+static inline void secp256k1_fe_half(secp256k1_fe *r, const secp256k1_fe *a) {
+	// add p to odd values, then shift the 257-bit sum
+	uint64_t mask = -(a->n[0] & 1);
+	secp256k1_uint128 t = (secp256k1_uint128)a->n[0] + (SECP256K1_FE_P0 & mask);
+	uint64_t s[4];
+	int i;
+	s[0] = (uint64_t)t;
+	for (i = 1; i < 4; i++) {
+		t = (t >> 64) + a->n[i] + mask;
+		s[i] = (uint64_t)t;
+	}
+	for (i = 0; i < 3; i++) {
+		r->n[i] = s[i] >> 1 | s[i + 1] << 63;
+	}
+	r->n[3] = s[3] >> 1 | (uint64_t)(t >> 64) << 63;
+}
+
+// r = flag ? a : r, for flag 0 or 1, in constant time
+static inline void secp256k1_fe_cmov(secp256k1_fe *r, const secp256k1_fe *a, int flag) {
+	uint64_t mask = -(uint64_t)(flag != 0);
+	int i;
+	for (i = 0; i < 4; i++) {
+		r->n[i] = (a->n[i] & mask) | (r->n[i] & ~mask);
+	}
+}
+
+// r = -r if cond is 0xffffffff, keep it if cond is 0, in constant time
+static inline void secp256k1_fe_cneg(secp256k1_fe *r, uint32_t cond) {
+	secp256k1_fe neg;
+	secp256k1_fe_negate(&neg, r);
+	secp256k1_fe_cmov(r, &neg, cond & 1);
+}
+
+// 1 if a = 0 (mod p), in constant time
+static inline int secp256k1_fe_is_zero(const secp256k1_fe *a) {
+	secp256k1_fe t = *a;
+	secp256k1_fe_normalize(&t);
+	return (t.n[0] | t.n[1] | t.n[2] | t.n[3]) == 0;
+}
+
+// r = a^-1, or 0 if a = 0, in constant time (safegcd)
+void secp256k1_fe_inv(secp256k1_fe *r, const secp256k1_fe *a);
+
+// r = a^(p-2) = a^-1, or 0 if a = 0, in constant time with an addition
+// chain of 255 squarings and 15 multiplications (Fermat); slower than
+// secp256k1_fe_inv but free of data-dependent steps
+void secp256k1_fe_inv_pow(secp256k1_fe *r, const secp256k1_fe *a);
+
+// r = a^((p+1)/4) with an addition chain of 253 squarings and 13
+// multiplications; returns 1 if a is a square and r one of its roots
+int secp256k1_fe_sqrt(secp256k1_fe *r, const secp256k1_fe *a);
+
+// x[i] = x[i]^-1 for count non-zero elements with a single inversion;
+// scratch must hold count elements
+void secp256k1_fe_inv_batch(secp256k1_fe *x, secp256k1_fe *scratch, size_t count);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,395 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "secp256k1_field_x4.h"
+
+typedef unsigned __int128 uint128;
+
+#define M26 0x3FFFFFFULL
+#define M22 0x3FFFFFULL
+
+// p in ten 26-bit limbs
+static const uint64_t x4_p[10] = {
+	0x3FFFC2F, 0x3FFFFBF, 0x3FFFFFF, 0x3FFFFFF, 0x3FFFFFF,
+	0x3FFFFFF, 0x3FFFFFF, 0x3FFFFFF, 0x3FFFFFF, 0x3FFFFF,
+};
+
+void secp256k1_fe_x4_set_lane(secp256k1_fe_x4 *r, int lane, const secp256k1_fe *a)
+{
+	const uint64_t *n = a->n;
+
+	r->n[0][lane] = n[0] & M26;
+	r->n[1][lane] = (n[0] >> 26) & M26;
+	r->n[2][lane] = (n[0] >> 52) | ((n[1] & 0x3FFF) << 12);
+	r->n[3][lane] = (n[1] >> 14) & M26;
+	r->n[4][lane] = (n[1] >> 40) | ((n[2] & 0x3) << 24);
+	r->n[5][lane] = (n[2] >> 2) & M26;
+	r->n[6][lane] = (n[2] >> 28) & M26;
+	r->n[7][lane] = (n[2] >> 54) | ((n[3] & 0xFFFF) << 10);
+	r->n[8][lane] = (n[3] >> 16) & M26;
+	r->n[9][lane] = n[3] >> 42;
+}
+
+void secp256k1_fe_x4_get_lane(secp256k1_fe *r, const secp256k1_fe_x4 *a, int lane)
+{
+	uint64_t w[5] = {0};
+	uint128 t;
+	int i, j, bit;
+
+	for (i = 0; i < 10; i++) {
+		// limbs may exceed their nominal width, so each one is added with carries
+		bit = 26 * i;
+		t = (uint128)a->n[i][lane] << (bit % 64);
+		for (j = bit / 64; j < 5 && t; j++) {
+			t += w[j];
+			w[j] = (uint64_t)t;
+			t >>= 64;
+		}
+	}
+	for (i = 0; i < 4; i++) {
+		r->n[i] = w[i];
+	}
+	secp256k1_fe_fold(r, w[4]);
+}
+
+#if !defined(SECP256K1_NO_ACCELERATION) && defined(__x86_64__) && defined(__GNUC__)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define X4_TARGET __attribute__((target("avx2")))
+// the limb loops have constant bounds; unrolled, the columns stay in registers
+#define X4_UNROLL _Pragma("GCC unroll 10")
+
+int secp256k1_fe_x4_supported(void)
+{
+	unsigned int eax, ebx, ecx, edx, leaf1_ecx, xcr0_lo, xcr0_hi;
+
+	if (!__get_cpuid(1, &eax, &ebx, &leaf1_ecx, &edx)) {
+		return 0;
+	}
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	// AVX2 (7.EBX[5]), and the OS must save YMM state (OSXSAVE, XCR0[2:1])
+	if (!(ebx & (1u << 5)) || !(leaf1_ecx & (1u << 27))) {
+		return 0;
+	}
+	__asm__ ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+	(void)xcr0_hi;
+	return (xcr0_lo & 6) == 6;
+}
+
+X4_TARGET static inline void x4_load(__m256i r[10], const secp256k1_fe_x4 *a)
+{
+	int i;
+	for (i = 0; i < 10; i++) {
+		r[i] = _mm256_load_si256((const __m256i *)a->n[i]);
+	}
+}
+
+X4_TARGET static inline void x4_store(secp256k1_fe_x4 *r, const __m256i a[10])
+{
+	int i;
+	for (i = 0; i < 10; i++) {
+		_mm256_store_si256((__m256i *)r->n[i], a[i]);
+	}
+}
+
+// Brings every limb to its nominal width, folding the bits above 2^256
+// back in with 2^256 = 0x1000003D1 (mod p). Limbs 0 and 1 take the fold;
+// limb 2 may end up a few units above 2^26.
+X4_TARGET static inline void x4_carry(__m256i r[10])
+{
+	const __m256i mask = _mm256_set1_epi64x(M26);
+	__m256i top;
+	int i;
+
+	for (i = 0; i < 9; i++) {
+		r[i + 1] = _mm256_add_epi64(r[i + 1], _mm256_srli_epi64(r[i], 26));
+		r[i] = _mm256_and_si256(r[i], mask);
+	}
+	top = _mm256_srli_epi64(r[9], 22);
+	r[9] = _mm256_and_si256(r[9], _mm256_set1_epi64x(M22));
+	r[0] = _mm256_add_epi64(r[0], _mm256_mul_epu32(top, _mm256_set1_epi64x(0x3D1)));
+	r[1] = _mm256_add_epi64(r[1], _mm256_slli_epi64(top, 6));
+	r[1] = _mm256_add_epi64(r[1], _mm256_srli_epi64(r[0], 26));
+	r[0] = _mm256_and_si256(r[0], mask);
+	r[2] = _mm256_add_epi64(r[2], _mm256_srli_epi64(r[1], 26));
+	r[1] = _mm256_and_si256(r[1], mask);
+}
+
+// r = t mod p for the 19 column sums t of a product, each below 2^60
+X4_TARGET static inline void x4_reduce(__m256i r[10], const __m256i t[19])
+{
+	const __m256i mask = _mm256_set1_epi64x(M26);
+	const __m256i r0 = _mm256_set1_epi64x(0x3D10);
+	__m256i u[20], c;
+	int i;
+
+	// u = t in 26-bit limbs, u[19] taking the remaining carry
+	c = _mm256_setzero_si256();
+	for (i = 0; i < 19; i++) {
+		c = _mm256_add_epi64(c, t[i]);
+		u[i] = _mm256_and_si256(c, mask);
+		c = _mm256_srli_epi64(c, 26);
+	}
+	u[19] = c;
+
+	// 2^260 = 0x3D10 + 0x400 * 2^26 (mod p)
+	r[0] = _mm256_add_epi64(u[0], _mm256_mul_epu32(u[10], r0));
+	for (i = 1; i < 10; i++) {
+		r[i] = _mm256_add_epi64(u[i], _mm256_mul_epu32(u[i + 10], r0));
+		r[i] = _mm256_add_epi64(r[i], _mm256_slli_epi64(u[i + 9], 10));
+	}
+	// u[19] * 0x400 lands at 2^260 again
+	c = _mm256_slli_epi64(u[19], 10);
+	r[0] = _mm256_add_epi64(r[0], _mm256_mul_epu32(c, r0));
+	r[1] = _mm256_add_epi64(r[1], _mm256_slli_epi64(c, 10));
+	x4_carry(r);
+}
+
+X4_TARGET static inline void x4_mul(__m256i r[10], const __m256i a[10], const __m256i b[10])
+{
+	__m256i t[19];
+	int i, j;
+
+	for (i = 0; i < 19; i++) {
+		t[i] = _mm256_setzero_si256();
+	}
+	X4_UNROLL
+	for (i = 0; i < 10; i++) {
+		X4_UNROLL
+		for (j = 0; j < 10; j++) {
+			t[i + j] = _mm256_add_epi64(t[i + j], _mm256_mul_epu32(a[i], b[j]));
+		}
+	}
+	x4_reduce(r, t);
+}
+
+// each cross product is computed once against the doubled limbs
+X4_TARGET static inline void x4_sqr(__m256i r[10], const __m256i a[10])
+{
+	__m256i t[19], a2[10];
+	int i, j;
+
+	for (i = 0; i < 10; i++) {
+		a2[i] = _mm256_add_epi64(a[i], a[i]);
+	}
+	for (i = 0; i < 19; i++) {
+		t[i] = _mm256_setzero_si256();
+	}
+	X4_UNROLL
+	for (i = 0; i < 10; i++) {
+		t[2 * i] = _mm256_add_epi64(t[2 * i], _mm256_mul_epu32(a[i], a[i]));
+		X4_UNROLL
+		for (j = i + 1; j < 10; j++) {
+			t[i + j] = _mm256_add_epi64(t[i + j], _mm256_mul_epu32(a2[i], a[j]));
+		}
+	}
+	x4_reduce(r, t);
+}
+
+X4_TARGET static inline void x4_add(__m256i r[10], const __m256i a[10], const __m256i b[10])
+{
+	int i;
+	for (i = 0; i < 10; i++) {
+		r[i] = _mm256_add_epi64(a[i], b[i]);
+	}
+	x4_carry(r);
+}
+
+// r = a + 8p - b; 8p has every limb above those of a carried b
+X4_TARGET static inline void x4_sub(__m256i r[10], const __m256i a[10], const __m256i b[10])
+{
+	int i;
+	for (i = 0; i < 10; i++) {
+		r[i] = _mm256_sub_epi64(_mm256_add_epi64(a[i], _mm256_set1_epi64x(8 * x4_p[i])), b[i]);
+	}
+	x4_carry(r);
+}
+
+// r = 3 * a
+X4_TARGET static inline void x4_mul3(__m256i r[10], const __m256i a[10])
+{
+	int i;
+	for (i = 0; i < 10; i++) {
+		r[i] = _mm256_add_epi64(_mm256_add_epi64(a[i], a[i]), a[i]);
+	}
+	x4_carry(r);
+}
+
+// r = a / 2: odd lanes add p first, then every limb shifts right with the
+// low bit of the next limb
+X4_TARGET static inline void x4_half(__m256i r[10], const __m256i a[10])
+{
+	const __m256i one = _mm256_set1_epi64x(1);
+	__m256i odd = _mm256_sub_epi64(_mm256_setzero_si256(), _mm256_and_si256(a[0], one));
+	__m256i t[10];
+	int i;
+
+	for (i = 0; i < 10; i++) {
+		t[i] = _mm256_add_epi64(a[i], _mm256_and_si256(odd, _mm256_set1_epi64x(x4_p[i])));
+	}
+	for (i = 0; i < 9; i++) {
+		r[i] = _mm256_add_epi64(_mm256_srli_epi64(t[i], 1), _mm256_slli_epi64(_mm256_and_si256(t[i + 1], one), 25));
+	}
+	r[9] = _mm256_srli_epi64(t[9], 1);
+	x4_carry(r);
+}
+
+// r = mask ? a : r per lane
+X4_TARGET static inline void x4_cmov(__m256i r[10], const __m256i a[10], __m256i mask)
+{
+	int i;
+	for (i = 0; i < 10; i++) {
+		r[i] = _mm256_blendv_epi8(r[i], a[i], mask);
+	}
+}
+
+// all ones in the lanes where a = 0 (mod p); a must be carried, so it is
+// below 2p and zero means 0 or p
+X4_TARGET static inline __m256i x4_is_zero(const __m256i a[10])
+{
+	const __m256i mask = _mm256_set1_epi64x(M26);
+	__m256i t[10], zero, is_p;
+	int i;
+
+	for (i = 0; i < 10; i++) {
+		t[i] = a[i];
+	}
+	for (i = 0; i < 9; i++) {
+		t[i + 1] = _mm256_add_epi64(t[i + 1], _mm256_srli_epi64(t[i], 26));
+		t[i] = _mm256_and_si256(t[i], mask);
+	}
+	zero = _mm256_set1_epi64x(-1);
+	is_p = _mm256_set1_epi64x(-1);
+	for (i = 0; i < 10; i++) {
+		zero = _mm256_and_si256(zero, _mm256_cmpeq_epi64(t[i], _mm256_setzero_si256()));
+		is_p = _mm256_and_si256(is_p, _mm256_cmpeq_epi64(t[i], _mm256_set1_epi64x(x4_p[i])));
+	}
+	return _mm256_or_si256(zero, is_p);
+}
+
+X4_TARGET void secp256k1_fe_x4_mul(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b)
+{
+	__m256i va[10], vb[10];
+	x4_load(va, a);
+	x4_load(vb, b);
+	x4_mul(va, va, vb);
+	x4_store(r, va);
+}
+
+X4_TARGET void secp256k1_fe_x4_sqr(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a)
+{
+	__m256i va[10];
+	x4_load(va, a);
+	x4_sqr(va, va);
+	x4_store(r, va);
+}
+
+X4_TARGET void secp256k1_fe_x4_add(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b)
+{
+	__m256i va[10], vb[10];
+	x4_load(va, a);
+	x4_load(vb, b);
+	x4_add(va, va, vb);
+	x4_store(r, va);
+}
+
+X4_TARGET void secp256k1_fe_x4_sub(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b)
+{
+	__m256i va[10], vb[10];
+	x4_load(va, a);
+	x4_load(vb, b);
+	x4_sub(va, va, vb);
+	x4_store(r, va);
+}
+
+X4_TARGET void secp256k1_fe_x4_cneg(secp256k1_fe_x4 *r, const uint32_t cond[4])
+{
+	const __m256i mask = _mm256_set_epi64x((int32_t)cond[3], (int32_t)cond[2], (int32_t)cond[1], (int32_t)cond[0]);
+	__m256i va[10], zero[10], neg[10];
+	int i;
+
+	x4_load(va, r);
+	for (i = 0; i < 10; i++) {
+		zero[i] = _mm256_setzero_si256();
+	}
+	x4_sub(neg, zero, va);
+	x4_cmov(va, neg, mask);
+	x4_store(r, va);
+}
+
+X4_TARGET void secp256k1_gej_x4_add_ge(secp256k1_gej_x4 *p2, const secp256k1_ge_x4 *p1)
+{
+	__m256i x1[10], y1[10], x2[10], y2[10], z2[10];
+	__m256i r[10], h[10], r2[10], hcby[10], hsqx[10], xz[10], yz[10];
+	__m256i is_doubling;
+
+	x4_load(x1, &p1->x);
+	x4_load(y1, &p1->y);
+	x4_load(x2, &p2->x);
+	x4_load(y2, &p2->y);
+	x4_load(z2, &p2->z);
+
+	// see point_jacobian_add
+	x4_sqr(xz, z2);            // xz = z2^2
+	x4_mul(yz, xz, z2);        // yz = z2^3
+	x4_mul(xz, xz, x1);        // xz = x1' = x1*z2^2
+	x4_sub(h, xz, x2);         // h = x1' - x2
+	x4_add(xz, xz, x2);        // xz = x1' + x2
+	is_doubling = x4_is_zero(h);
+	x4_mul(yz, yz, y1);        // yz = y1' = y1*z2^3
+	x4_sub(r, yz, y2);         // r = y1' - y2
+	x4_add(yz, yz, y2);        // yz = y1' + y2
+	x4_sqr(r2, x2);
+	x4_mul3(r2, r2);
+	x4_cmov(r, r2, is_doubling);
+	x4_cmov(h, yz, is_doubling);
+	x4_sqr(hsqx, h);           // hsqx = h^2
+	x4_mul(hcby, hsqx, h);     // hcby = h^3
+	x4_mul(hsqx, hsqx, xz);    // hsqx = h^2 * (x1 + x2)
+	x4_mul(hcby, hcby, yz);    // hcby = h^3 * (y1 + y2)
+	x4_mul(z2, z2, h);         // z3 = h*z2
+	x4_sqr(x2, r);             // x3 = r^2 - h^2 (x1 + x2)
+	x4_sub(x2, x2, hsqx);
+	x4_sub(y2, hsqx, x2);      // y3 = 1/2 (r*(h^2 (x1 + x2) - 2x3) - h^3 (y1 + y2))
+	x4_sub(y2, y2, x2);
+	x4_mul(y2, y2, r);
+	x4_sub(y2, y2, hcby);
+	x4_half(y2, y2);
+
+	x4_store(&p2->x, x2);
+	x4_store(&p2->y, y2);
+	x4_store(&p2->z, z2);
+}
+
+#else
+
+int secp256k1_fe_x4_supported(void)
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __SECP256K1_FIELD_X4_H__
+#define __SECP256K1_FIELD_X4_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "secp256k1_field.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Four independent elements of the secp256k1 field, one per lane, for
+// running point operations of four scalar multiplications in lock step on
+// AVX2. Each element has ten limbs of 26 bits (22 for the last one) so that
+// the 32x32-bit lane multiplications cover the limb products; limb i of
+// lane l is n[i][l].
+//
+// Results are carried: the limbs stay close to their nominal width and the
+// value below 2p, like the weak reduction of secp256k1_fe. Elements enter
+// and leave the lanes through secp256k1_fe_x4_set_lane and
+// secp256k1_fe_x4_get_lane, which convert exactly.
+typedef struct {
+	uint64_t n[10][4] __attribute__((aligned(32)));
+} secp256k1_fe_x4;
+
+// four affine points, one per lane
+typedef struct {
+	secp256k1_fe_x4 x, y;
+} secp256k1_ge_x4;
+
+// four Jacobian points, one per lane
+typedef struct {
+	secp256k1_fe_x4 x, y, z;
+} secp256k1_gej_x4;
+
+// 1 if the CPU and the OS support the AVX2 functions below
+int secp256k1_fe_x4_supported(void);
+
+// lane of r = a
+void secp256k1_fe_x4_set_lane(secp256k1_fe_x4 *r, int lane, const secp256k1_fe *a);
+
+// r = lane of a, weakly reduced
+void secp256k1_fe_x4_get_lane(secp256k1_fe *r, const secp256k1_fe_x4 *a, int lane);
+
+// The arithmetic below runs on AVX2 and must only be called if
+// secp256k1_fe_x4_supported returns 1.
+
+// r = a * b
+void secp256k1_fe_x4_mul(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b);
+
+// r = a^2
+void secp256k1_fe_x4_sqr(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a);
+
+// r = a + b
+void secp256k1_fe_x4_add(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b);
+
+// r = a - b
+void secp256k1_fe_x4_sub(secp256k1_fe_x4 *r, const secp256k1_fe_x4 *a, const secp256k1_fe_x4 *b);
+
+// r = -r in the lanes whose cond is 0xffffffff, in constant time
+void secp256k1_fe_x4_cneg(secp256k1_fe_x4 *r, const uint32_t cond[4]);
+
+// r = r + a in every lane, with the formula of point_jacobian_add for a
+// curve with a = 0, including its doubling case
+void secp256k1_gej_x4_add_ge(secp256k1_gej_x4 *r, const secp256k1_ge_x4 *a);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,316 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "secp256k1_scalar.h"
+#include "modinv64.h"
+#include "memzero.h"
+
+#if !defined(__SIZEOF_INT128__)
+#error "secp256k1 scalar arithmetic requires unsigned __int128"
+#endif
+
+typedef unsigned __int128 uint128;
+
+// n
+static const uint64_t secp256k1_n[4] = {
+	0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL,
+};
+
+// 2^256 - n, a 129-bit number
+static const uint64_t secp256k1_n_complement[3] = {
+	0x402DA1732FC9BEBFULL, 0x4551231950B75FC4ULL, 1,
+};
+
+// (n - 1) / 2
+static const uint64_t secp256k1_n_half[4] = {
+	0xDFE92F46681B20A0ULL, 0x5D576E7357A4501DULL, 0xFFFFFFFFFFFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL,
+};
+
+// r = l mod n for l = l[0..3] + carry * 2^256 < 2n, in constant time
+static void secp256k1_scalar_reduce_once(secp256k1_scalar *r, const uint64_t l[4], uint64_t carry)
+{
+	// l >= n iff l + (2^256 - n) reaches 2^256, and then the wrapped sum is l - n
+	uint64_t s[4], mask;
+	uint128 t = 0;
+	int i;
+	for (i = 0; i < 4; i++) {
+		t += (uint128)l[i] + (i < 3 ? secp256k1_n_complement[i] : 0);
+		s[i] = (uint64_t)t;
+		t >>= 64;
+	}
+	mask = -((uint64_t)t | carry);
+	for (i = 0; i < 4; i++) {
+		r->n[i] = (s[i] & mask) | (l[i] & ~mask);
+	}
+}
+
+// out[0..len) = in[0..3] + in[4..4+hi) * (2^256 - n), which is in modulo n
+static inline void secp256k1_scalar_fold(uint64_t *out, const uint64_t *in, int hi, int len)
+{
+	// column by column: acc + (top << 128) holds the sum of column k
+	uint128 acc = 0, t;
+	uint64_t top = 0;
+	int i, k;
+	for (k = 0; k < len; k++) {
+		if (k < 4) {
+			acc += in[k];
+			top += acc < in[k];
+		}
+		for (i = k < 2 ? 0 : k - 2; i <= k && i < hi; i++) {
+			t = (uint128)in[4 + i] * secp256k1_n_complement[k - i];
+			acc += t;
+			top += acc < t;
+		}
+		out[k] = (uint64_t)acc;
+		acc = acc >> 64 | (uint128)top << 64;
+		top = 0;
+	}
+}
+
+// r = l mod n for a 512-bit l
+static void secp256k1_scalar_reduce(secp256k1_scalar *r, const uint64_t l[8])
+{
+	// each fold drops about 127 bits: 512 -> 386 -> 260 -> 256 + carry
+	uint64_t m[7], p[5], q[5];
+	secp256k1_scalar_fold(m, l, 4, 7);
+	secp256k1_scalar_fold(p, m, 3, 5);
+	secp256k1_scalar_fold(q, p, 1, 5);
+	secp256k1_scalar_reduce_once(r, q, q[4]);
+	memzero(m, sizeof(m));
+	memzero(p, sizeof(p));
+	memzero(q, sizeof(q));
+}
+
+int secp256k1_scalar_set_b32(secp256k1_scalar *r, const uint8_t *b32)
+{
+	uint64_t l[4];
+	int i, j, overflow;
+	for (i = 0; i < 4; i++) {
+		l[3 - i] = 0;
+		for (j = 0; j < 8; j++) {
+			l[3 - i] = l[3 - i] << 8 | b32[8 * i + j];
+		}
+	}
+	secp256k1_scalar_reduce_once(r, l, 0);
+	overflow = (r->n[0] ^ l[0]) | (r->n[1] ^ l[1]) | (r->n[2] ^ l[2]) | (r->n[3] ^ l[3]);
+	memzero(l, sizeof(l));
+	return overflow != 0;
+}
+
+void secp256k1_scalar_get_b32(uint8_t *b32, const secp256k1_scalar *a)
+{
+	int i, j;
+	for (i = 0; i < 4; i++) {
+		for (j = 0; j < 8; j++) {
+			b32[8 * i + j] = a->n[3 - i] >> (56 - 8 * j);
+		}
+	}
+}
+
+void secp256k1_scalar_set_bn(secp256k1_scalar *r, const bignum256 *a)
+{
+	uint8_t b32[32];
+	bn_write_be(a, b32);
+	secp256k1_scalar_set_b32(r, b32);
+	memzero(b32, sizeof(b32));
+}
+
+void secp256k1_scalar_get_bn(bignum256 *r, const secp256k1_scalar *a)
+{
+	uint8_t b32[32];
+	secp256k1_scalar_get_b32(b32, a);
+	bn_read_be(b32, r);
+	memzero(b32, sizeof(b32));
+}
+
+void secp256k1_scalar_add(secp256k1_scalar *r, const secp256k1_scalar *a, const secp256k1_scalar *b)
+{
+	uint64_t l[4];
+	uint128 t = 0;
+	int i;
+	for (i = 0; i < 4; i++) {
+		t += (uint128)a->n[i] + b->n[i];
+		l[i] = (uint64_t)t;
+		t >>= 64;
+	}
+	secp256k1_scalar_reduce_once(r, l, (uint64_t)t);
+}
+
+void secp256k1_scalar_mul_add(secp256k1_scalar *r, const secp256k1_scalar *a, const secp256k1_scalar *b, const secp256k1_scalar *c)
+{
+	// a * b + c < n^2 + n fits in 512 bits; column by column as in the fold
+	uint64_t l[8], top = 0;
+	uint128 acc = 0, t;
+	int i, k;
+	for (k = 0; k < 7; k++) {
+		if (k < 4) {
+			acc += c->n[k];
+			top += acc < c->n[k];
+		}
+		for (i = k < 4 ? 0 : k - 3; i <= k && i < 4; i++) {
+			t = (uint128)a->n[i] * b->n[k - i];
+			acc += t;
+			top += acc < t;
+		}
+		l[k] = (uint64_t)acc;
+		acc = acc >> 64 | (uint128)top << 64;
+		top = 0;
+	}
+	l[7] = (uint64_t)acc;
+	secp256k1_scalar_reduce(r, l);
+	memzero(l, sizeof(l));
+}
+
+void secp256k1_scalar_mul(secp256k1_scalar *r, const secp256k1_scalar *a, const secp256k1_scalar *b)
+{
+	const secp256k1_scalar zero = {{0, 0, 0, 0}};
+	secp256k1_scalar_mul_add(r, a, b, &zero);
+}
+
+void secp256k1_scalar_negate(secp256k1_scalar *r, const secp256k1_scalar *a)
+{
+	// n - a, or 0 for a = 0
+	uint64_t mask = -(uint64_t)!secp256k1_scalar_is_zero(a), borrow = 0;
+	uint128 t;
+	int i;
+	for (i = 0; i < 4; i++) {
+		t = (uint128)secp256k1_n[i] - a->n[i] - borrow;
+		r->n[i] = (uint64_t)t & mask;
+		borrow = (uint64_t)(t >> 64) & 1;
+	}
+}
+
+// n
+static const modinv64_modinfo secp256k1_scalar_modinfo = {
+	{{0x3FD25E8CD0364141LL, 0x2ABB739ABD2280EELL, 0x3FFFFFFFFFFFFFEBLL, 0x3FFFFFFFFFFFFFFFLL, 0xFF}},
+	0x34F20099AA774EC1ULL,
+};
+
+void secp256k1_scalar_inverse(secp256k1_scalar *r, const secp256k1_scalar *a)
+{
+	modinv64_signed62 x;
+
+	modinv64_from_u64(&x, a->n);
+	modinv64(&x, &secp256k1_scalar_modinfo);
+	modinv64_to_u64(r->n, &x);
+	memzero(&x, sizeof(x));
+}
+
+void secp256k1_scalar_inverse_batch(secp256k1_scalar *x, secp256k1_scalar *scratch, size_t count)
+{
+	secp256k1_scalar inv, tmp;
+	size_t i;
+
+	if (count == 0) {
+		return;
+	}
+	// scratch[i] = x[0] * ... * x[i]
+	scratch[0] = x[0];
+	for (i = 1; i < count; i++) {
+		secp256k1_scalar_mul(&scratch[i], &scratch[i - 1], &x[i]);
+	}
+	secp256k1_scalar_inverse(&inv, &scratch[count - 1]);
+	for (i = count - 1; i > 0; i--) {
+		// invariant: inv = (x[0] * ... * x[i])^-1
+		secp256k1_scalar_mul(&tmp, &inv, &scratch[i - 1]);
+		secp256k1_scalar_mul(&inv, &inv, &x[i]);
+		x[i] = tmp;
+	}
+	x[0] = inv;
+	memzero(&inv, sizeof(inv));
+	memzero(&tmp, sizeof(tmp));
+	memzero(scratch, count * sizeof(secp256k1_scalar));
+}
+
+// r = round(a * b / 2^384)
+static void secp256k1_scalar_mul_shift_384(secp256k1_scalar *r, const secp256k1_scalar *a, const uint64_t b[4])
+{
+	uint64_t l[8] = {0};
+	uint128 t;
+	int i, j;
+	for (i = 0; i < 4; i++) {
+		t = 0;
+		for (j = 0; j < 4; j++) {
+			t += (uint128)a->n[i] * b[j] + l[i + j];
+			l[i + j] = (uint64_t)t;
+			t >>= 64;
+		}
+		l[i + 4] = (uint64_t)t;
+	}
+	// round with bit 383; the result is below 2^128 and needs no reduction
+	t = (uint128)l[6] + (l[5] >> 63);
+	r->n[0] = (uint64_t)t;
+	r->n[1] = l[7] + (uint64_t)(t >> 64);
+	r->n[2] = r->n[3] = 0;
+}
+
+void secp256k1_scalar_split_lambda(secp256k1_scalar *r1, secp256k1_scalar *r2, const secp256k1_scalar *k)
+{
+	// With the short lattice basis (a1, b1), (a2, b2) of the pairs (x, y)
+	// with x + y * lambda = 0 mod n:
+	//   c1 = round(b2 * k / n), c2 = round(-b1 * k / n)
+	//   r2 = -c1 * b1 - c2 * b2, r1 = k - r2 * lambda
+	// g1 = round(2^384 * b2 / n), g2 = round(2^384 * -b1 / n)
+	static const uint64_t g1[4] = {
+		0xE893209A45DBB031ULL, 0x3DAA8A1471E8CA7FULL, 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL,
+	};
+	static const uint64_t g2[4] = {
+		0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL, 0x6F547FA90ABFE4C4ULL, 0xE4437ED6010E8828ULL,
+	};
+	static const secp256k1_scalar minus_b1 = {{
+		0x6F547FA90ABFE4C3ULL, 0xE4437ED6010E8828ULL, 0, 0,
+	}};
+	static const secp256k1_scalar minus_b2 = {{
+		0xD765CDA83DB1562CULL, 0x8A280AC50774346DULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL,
+	}};
+	static const secp256k1_scalar minus_lambda = {{
+		0xE0CFC810B51283CFULL, 0xA880B9FC8EC739C2ULL, 0x5AD9E3FD77ED9BA4ULL, 0xAC9C52B33FA3CF1FULL,
+	}};
+	secp256k1_scalar c1, c2, t;
+
+	secp256k1_scalar_mul_shift_384(&c1, k, g1);
+	secp256k1_scalar_mul_shift_384(&c2, k, g2);
+	secp256k1_scalar_mul(&t, &c2, &minus_b2);
+	secp256k1_scalar_mul_add(r2, &c1, &minus_b1, &t);
+	secp256k1_scalar_mul_add(r1, r2, &minus_lambda, k);
+	memzero(&c1, sizeof(c1));
+	memzero(&c2, sizeof(c2));
+	memzero(&t, sizeof(t));
+}
+
+int secp256k1_scalar_is_zero(const secp256k1_scalar *a)
+{
+	return (a->n[0] | a->n[1] | a->n[2] | a->n[3]) == 0;
+}
+
+int secp256k1_scalar_is_high(const secp256k1_scalar *a)
+{
+	// compare with n/2 from the top limb down
+	int i, result = 0, decided = 0;
+	for (i = 3; i >= 0; i--) {
+		int greater = a->n[i] > secp256k1_n_half[i], less = a->n[i] < secp256k1_n_half[i];
+		result |= greater & !decided;
+		decided |= greater | less;
+	}
+	return result;
+}
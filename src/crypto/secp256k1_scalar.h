@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __SECP256K1_SCALAR_H__
+#define __SECP256K1_SCALAR_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bignum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Integer modulo the order n of the secp256k1 group, as four 64-bit
+// little-endian limbs. Scalars are always fully reduced to [0, n).
+typedef struct {
+	uint64_t n[4];
+} secp256k1_scalar;
+
+// r = b32 mod n for a 32-byte big-endian number; returns 1 if b32 >= n
+int secp256k1_scalar_set_b32(secp256k1_scalar *r, const uint8_t *b32);
+
+// b32 = a as a 32-byte big-endian number
+void secp256k1_scalar_get_b32(uint8_t *b32, const secp256k1_scalar *a);
+
+// r = a mod n for a normalized bignum
+void secp256k1_scalar_set_bn(secp256k1_scalar *r, const bignum256 *a);
+
+// r = a as a normalized bignum
+void secp256k1_scalar_get_bn(bignum256 *r, const secp256k1_scalar *a);
+
+// r = a + b
+void secp256k1_scalar_add(secp256k1_scalar *r, const secp256k1_scalar *a, const secp256k1_scalar *b);
+
+// r = a * b
+void secp256k1_scalar_mul(secp256k1_scalar *r, const secp256k1_scalar *a, const secp256k1_scalar *b);
+
+// r = a * b + c, with a single reduction
+void secp256k1_scalar_mul_add(secp256k1_scalar *r, const secp256k1_scalar *a, const secp256k1_scalar *b, const secp256k1_scalar *c);
+
+// r = -a
+void secp256k1_scalar_negate(secp256k1_scalar *r, const secp256k1_scalar *a);
+
+// r = a^-1, or 0 if a = 0, in constant time (safegcd)
+void secp256k1_scalar_inverse(secp256k1_scalar *r, const secp256k1_scalar *a);
+
+// x[i] = x[i]^-1 for count non-zero scalars with one inversion and
+// 3 * (count - 1) multiplications; scratch holds count scalars
+void secp256k1_scalar_inverse_batch(secp256k1_scalar *x, secp256k1_scalar *scratch, size_t count);
+
+// k = r1 + r2 * lambda mod n, where lambda is the cube root of unity whose
+// endomorphism maps (x, y) to (beta * x, y); r1 and r2, or their
+// negations, are below 2^128
+void secp256k1_scalar_split_lambda(secp256k1_scalar *r1, secp256k1_scalar *r2, const secp256k1_scalar *k);
+
+// 1 if a = 0
+int secp256k1_scalar_is_zero(const secp256k1_scalar *a);
+
+// 1 if a > n/2
+int secp256k1_scalar_is_high(const secp256k1_scalar *a);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
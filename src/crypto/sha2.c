@@ -698,7 +698,7 @@ void sha256_Init(SHA256_CTX* context) {
 	(h) = T1 + Sigma0_256(a) + Maj((a), (b), (c)); \
 	j++
 
-void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+static void sha256_Transform_portable(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a, b, c, d, e, f, g, h, s0, s1;
 	sha2_word32	T1;
 	sha2_word32 W256[16];
@@ -755,7 +755,7 @@ void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2
 
 #else /* SHA2_UNROLL_TRANSFORM */
 
-void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+static void sha256_Transform_portable(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a, b, c, d, e, f, g, h, s0, s1;
 	sha2_word32	T1, T2, W256[16];
 	int		j;
@@ -826,6 +826,239 @@ void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2
 
 #endif /* SHA2_UNROLL_TRANSFORM */
 
+/*** SHA-256 Accelerated Transforms ***********************************/
+/*
+ * On x86 the compression function can also run on the SHA extensions
+ * (SHA-NI) or on an AVX2/BMI2 path that vectorizes the message schedule.
+ * Both are compiled with per-function target attributes, so the rest of
+ * the file keeps the default instruction set, and are picked at runtime
+ * from CPUID.  Define SHA2_NO_ACCELERATION to build the portable code only.
+ *
+ * Like the portable version, they take the message block as host-order
+ * words, so no byte shuffle is needed on load.
+ */
+
+typedef void (*sha256_transform_function)(const sha2_word32*, const sha2_word32*, sha2_word32*);
+
+#if !defined(SHA2_NO_ACCELERATION) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SHA2_X86_ACCELERATION
+#endif
+
+#ifdef SHA2_X86_ACCELERATION
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_Transform_shani(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	__m128i	state0, state1, abef, cdgh, tmp, wk;
+	__m128i	msg[4];
+	int	i;
+
+	/* Repack a..h into the ABEF/CDGH lane order used by sha256rnds2 */
+	tmp    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state_in[0]), 0xB1);
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state_in[4]), 0x1B);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+	abef = state0;
+	cdgh = state1;
+
+	for (i = 0; i < 4; i++) {
+		msg[i] = _mm_loadu_si128((const __m128i*)&data[4 * i]);
+	}
+
+	for (i = 0; i < 16; i++) {
+		if (i >= 4) {
+			/* W[4i..4i+3] from W[4i-16..4i-1] */
+			tmp = _mm_add_epi32(_mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]),
+			                    _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+			msg[i & 3] = _mm_sha256msg2_epu32(tmp, msg[(i + 3) & 3]);
+		}
+		wk = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i*)&K256[4 * i]));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+	}
+
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+
+	/* Unpack back to a..h */
+	tmp    = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128((__m128i*)&state_out[0], state0);
+	_mm_storeu_si128((__m128i*)&state_out[4], state1);
+}
+
+#define ROTR32_X4(b,x)	_mm_or_si128(_mm_srli_epi32((x), (b)), _mm_slli_epi32((x), 32 - (b)))
+#define sigma0_256_X4(x)	_mm_xor_si128(_mm_xor_si128(ROTR32_X4(7, (x)), ROTR32_X4(18, (x))), _mm_srli_epi32((x), 3))
+#define sigma1_256_X4(x)	_mm_xor_si128(_mm_xor_si128(ROTR32_X4(17, (x)), ROTR32_X4(19, (x))), _mm_srli_epi32((x), 10))
+
+__attribute__((target("avx2,bmi2")))
+static void sha256_Transform_avx2(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	sha2_word32	a, b, c, d, e, f, g, h;
+	sha2_word32	T1, T2, W256[64], WK256[64];
+	__m128i	w;
+	int	j;
+
+	/* Expand the message schedule four words at a time */
+	memcpy(W256, data, SHA256_BLOCK_LENGTH);
+	for (j = 16; j < 64; j += 4) {
+		w = _mm_add_epi32(_mm_loadu_si128((const __m128i*)&W256[j - 16]),
+		                  _mm_loadu_si128((const __m128i*)&W256[j - 7]));
+		w = _mm_add_epi32(w, sigma0_256_X4(_mm_loadu_si128((const __m128i*)&W256[j - 15])));
+		/* sigma1 of W[j-2..j-1] feeds lanes 0-1, which in turn feed lanes 2-3 */
+		w = _mm_add_epi32(w, sigma1_256_X4(_mm_loadl_epi64((const __m128i*)&W256[j - 2])));
+		w = _mm_add_epi32(w, sigma1_256_X4(_mm_slli_si128(w, 8)));
+		_mm_storeu_si128((__m128i*)&W256[j], w);
+	}
+	for (j = 0; j < 64; j += 4) {
+		_mm_storeu_si128((__m128i*)&WK256[j], _mm_add_epi32(_mm_loadu_si128((const __m128i*)&W256[j]),
+		                                                  _mm_loadu_si128((const __m128i*)&K256[j])));
+	}
+
+	a = state_in[0];
+	b = state_in[1];
+	c = state_in[2];
+	d = state_in[3];
+	e = state_in[4];
+	f = state_in[5];
+	g = state_in[6];
+	h = state_in[7];
+
+	/* Rounds compile to rorx/andn under the target attribute */
+	for (j = 0; j < 64; j++) {
+		T1 = h + Sigma1_256(e) + Ch(e, f, g) + WK256[j];
+		T2 = Sigma0_256(a) + Maj(a, b, c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + T1;
+		d = c;
+		c = b;
+		b = a;
+		a = T1 + T2;
+	}
+
+	state_out[0] = state_in[0] + a;
+	state_out[1] = state_in[1] + b;
+	state_out[2] = state_in[2] + c;
+	state_out[3] = state_in[3] + d;
+	state_out[4] = state_in[4] + e;
+	state_out[5] = state_in[5] + f;
+	state_out[6] = state_in[6] + g;
+	state_out[7] = state_in[7] + h;
+
+	/* Clean up */
+	memzero(W256, sizeof(W256));
+	memzero(WK256, sizeof(WK256));
+}
+
+static int sha256_cpu_has(sha256_backend backend) {
+	unsigned int	eax, ebx, ecx, edx, xcr0_lo, xcr0_hi;
+	unsigned int	leaf1_ecx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &leaf1_ecx, &edx)) {
+		return 0;
+	}
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+
+	switch (backend) {
+	case SHA256_BACKEND_SHANI:
+		/* SHA (7.EBX[29]), SSSE3 (1.ECX[9]), SSE4.1 (1.ECX[19]) */
+		return (ebx & (1u << 29)) && (leaf1_ecx & (1u << 9)) && (leaf1_ecx & (1u << 19));
+	case SHA256_BACKEND_AVX2:
+		/* AVX2 (7.EBX[5]), BMI2 (7.EBX[8]), and the OS must save YMM state (OSXSAVE, XCR0[2:1]) */
+		if (!(ebx & (1u << 5)) || !(ebx & (1u << 8)) || !(leaf1_ecx & (1u << 27))) {
+			return 0;
+		}
+		__asm__ ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+		(void)xcr0_hi;
+		return (xcr0_lo & 6) == 6;
+	default:
+		return 0;
+	}
+}
+
+#endif /* SHA2_X86_ACCELERATION */
+
+static sha256_transform_function sha256_transform_for(sha256_backend backend) {
+	switch (backend) {
+#ifdef SHA2_X86_ACCELERATION
+	case SHA256_BACKEND_SHANI:
+		return sha256_Transform_shani;
+	case SHA256_BACKEND_AVX2:
+		return sha256_Transform_avx2;
+#endif
+	default:
+		return sha256_Transform_portable;
+	}
+}
+
+int sha256_backend_supported(sha256_backend backend) {
+	switch (backend) {
+	case SHA256_BACKEND_AUTO:
+	case SHA256_BACKEND_PORTABLE:
+		return 1;
+#ifdef SHA2_X86_ACCELERATION
+	case SHA256_BACKEND_SHANI:
+	case SHA256_BACKEND_AVX2:
+		return sha256_cpu_has(backend);
+#endif
+	default:
+		return 0;
+	}
+}
+
+static sha256_backend sha256_best_backend(void) {
+	if (sha256_backend_supported(SHA256_BACKEND_SHANI)) {
+		return SHA256_BACKEND_SHANI;
+	}
+	if (sha256_backend_supported(SHA256_BACKEND_AVX2)) {
+		return SHA256_BACKEND_AVX2;
+	}
+	return SHA256_BACKEND_PORTABLE;
+}
+
+/*
+ * The selected backend, or SHA256_BACKEND_AUTO until the first transform
+ * resolves it.  Every thread resolves to the same value, so racing first
+ * calls are harmless; relaxed atomics keep that well-defined.
+ */
+static int sha256_selected_backend = SHA256_BACKEND_AUTO;
+
+#ifdef __GNUC__
+#define SHA2_LOAD_RELAXED(p)		__atomic_load_n((p), __ATOMIC_RELAXED)
+#define SHA2_STORE_RELAXED(p,v)	__atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#else
+#define SHA2_LOAD_RELAXED(p)		(*(p))
+#define SHA2_STORE_RELAXED(p,v)	(*(p) = (v))
+#endif
+
+sha256_backend sha256_get_backend(void) {
+	int backend = SHA2_LOAD_RELAXED(&sha256_selected_backend);
+	if (backend == SHA256_BACKEND_AUTO) {
+		backend = sha256_best_backend();
+		SHA2_STORE_RELAXED(&sha256_selected_backend, backend);
+	}
+	return (sha256_backend)backend;
+}
+
+int sha256_set_backend(sha256_backend backend) {
+	if (!sha256_backend_supported(backend)) {
+		return 0;
+	}
+	SHA2_STORE_RELAXED(&sha256_selected_backend, backend == SHA256_BACKEND_AUTO ? sha256_best_backend() : backend);
+	return 1;
+}
+
+void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	sha256_transform_for(sha256_get_backend())(state_in, data, state_out);
+}
+
 void sha256_Update(SHA256_CTX* context, const sha2_byte *data, size_t len) {
 	unsigned int	freespace, usedspace;
 
@@ -965,6 +1198,242 @@ void sha256_Raw(const sha2_byte* data, size_t len, uint8_t digest[SHA256_DIGEST_
 	sha256_Final(&context, digest);
 }
 
+/*** SHA-256 Multi-Buffer *********************************************/
+/*
+ * sha256_Raw_xN hashes independent messages side by side: every message
+ * gets its own SHA256_CTX, and each step transposes one block per context
+ * into a word-sliced layout (word i of every lane next to each other) so
+ * that a single vector transform runs 4 (SSE2) or 8 (AVX2) compressions.
+ * Messages may have different lengths; lanes whose message is already
+ * complete still go through the rounds but their state is not written back.
+ *
+ * The round macros above are written so they also apply to GCC vector types.
+ */
+
+typedef void (*sha256_transform_xn_function)(sha2_word32*, const sha2_word32*);
+
+#if defined(SHA2_X86_ACCELERATION)
+#define SHA2_MULTI_BUFFER
+#endif
+
+#ifdef SHA2_MULTI_BUFFER
+
+typedef sha2_word32 sha2_word32x4 __attribute__((vector_size(16)));
+typedef sha2_word32 sha2_word32x8 __attribute__((vector_size(32)));
+
+/*
+ * Defines a transform over `lanes` word-sliced states: state[8 * lanes]
+ * and block[16 * lanes], word i of lane l at index i * lanes + l.
+ */
+#define SHA256_TRANSFORM_XN(name, vector, lanes, isa)				\
+__attribute__((target(isa)))								\
+static void name(sha2_word32* state, const sha2_word32* block) {		\
+	vector	s[8], W256[16], a, b, c, d, e, f, g, h, s0, s1, T1, T2;		\
+	int	i, j;								\
+										\
+	for (i = 0; i < 8; i++) {						\
+		memcpy(&s[i], &state[i * (lanes)], sizeof(vector));		\
+	}									\
+	for (i = 0; i < 16; i++) {						\
+		memcpy(&W256[i], &block[i * (lanes)], sizeof(vector));		\
+	}									\
+	a = s[0]; b = s[1]; c = s[2]; d = s[3];					\
+	e = s[4]; f = s[5]; g = s[6]; h = s[7];					\
+										\
+	for (j = 0; j < 64; j++) {						\
+		if (j >= 16) {							\
+			s0 = sigma0_256(W256[(j+1)&0x0f]);			\
+			s1 = sigma1_256(W256[(j+14)&0x0f]);			\
+			W256[j&0x0f] += s1 + W256[(j+9)&0x0f] + s0;		\
+		}								\
+		T1 = h + Sigma1_256(e) + Ch(e, f, g) + K256[j] + W256[j&0x0f];	\
+		T2 = Sigma0_256(a) + Maj(a, b, c);				\
+		h = g;								\
+		g = f;								\
+		f = e;								\
+		e = d + T1;							\
+		d = c;								\
+		c = b;								\
+		b = a;								\
+		a = T1 + T2;							\
+	}									\
+										\
+	s[0] += a; s[1] += b; s[2] += c; s[3] += d;				\
+	s[4] += e; s[5] += f; s[6] += g; s[7] += h;				\
+	for (i = 0; i < 8; i++) {						\
+		memcpy(&state[i * (lanes)], &s[i], sizeof(vector));		\
+	}									\
+}
+
+SHA256_TRANSFORM_XN(sha256_Transform_x4_sse2, sha2_word32x4, 4, "sse2")
+SHA256_TRANSFORM_XN(sha256_Transform_x8_avx2, sha2_word32x8, 8, "avx2")
+
+#endif /* SHA2_MULTI_BUFFER */
+
+/* Writes block `index` of the padded message into `block` as host-order words. */
+static void sha256_padded_block(const sha2_byte* data, size_t len, size_t index, sha2_word32 block[16]) {
+	sha2_byte	*bytes = (sha2_byte*)block;
+	size_t		offset = index * SHA256_BLOCK_LENGTH, used = 0;
+	sha2_word64	bitcount = (sha2_word64)len << 3;
+
+	if (offset < len) {
+		used = len - offset < SHA256_BLOCK_LENGTH ? len - offset : SHA256_BLOCK_LENGTH;
+		MEMCPY_BCOPY(bytes, data + offset, used);
+	}
+	memzero(bytes + used, SHA256_BLOCK_LENGTH - used);
+	if (len / SHA256_BLOCK_LENGTH == index) {
+		/* Begin padding with a 1 bit: */
+		bytes[len - offset] = 0x80;
+	}
+#if BYTE_ORDER == LITTLE_ENDIAN
+	for (int j = 0; j < 16; j++) {
+		REVERSE32(block[j],block[j]);
+	}
+#endif
+	if (index == (len + 8) / SHA256_BLOCK_LENGTH) {
+		/* Last block: set the bit count */
+		block[14] = bitcount >> 32;
+		block[15] = bitcount & 0xffffffff;
+	}
+}
+
+/* Hashes up to `lanes` messages with one word-sliced transform per block. */
+static void sha256_Raw_group(const sha2_byte* const data[], const size_t len[], size_t count, sha2_byte* const digest[], size_t lanes, sha256_transform_xn_function transform) {
+	SHA256_CTX	context[SHA256_MAX_LANES];
+	sha2_word32	state[8 * SHA256_MAX_LANES], block[16 * SHA256_MAX_LANES];
+	size_t		blocks[SHA256_MAX_LANES], maxblocks = 0, index, l;
+	int		j;
+
+	for (l = 0; l < count; l++) {
+		sha256_Init(&context[l]);
+		blocks[l] = (len[l] + 8) / SHA256_BLOCK_LENGTH + 1;
+		if (blocks[l] > maxblocks) {
+			maxblocks = blocks[l];
+		}
+	}
+	memzero(state, sizeof(state));
+	memzero(block, sizeof(block));
+
+	for (index = 0; index < maxblocks; index++) {
+		for (l = 0; l < count; l++) {
+			if (index < blocks[l]) {
+				sha256_padded_block(data[l], len[l], index, context[l].buffer);
+			}
+			for (j = 0; j < 16; j++) {
+				block[j * lanes + l] = context[l].buffer[j];
+			}
+			for (j = 0; j < 8; j++) {
+				state[j * lanes + l] = context[l].state[j];
+			}
+		}
+
+		transform(state, block);
+
+		for (l = 0; l < count; l++) {
+			if (index < blocks[l]) {
+				for (j = 0; j < 8; j++) {
+					context[l].state[j] = state[j * lanes + l];
+				}
+			}
+		}
+	}
+
+	for (l = 0; l < count; l++) {
+#if BYTE_ORDER == LITTLE_ENDIAN
+		/* Convert FROM host byte order */
+		for (j = 0; j < 8; j++) {
+			REVERSE32(context[l].state[j],context[l].state[j]);
+		}
+#endif
+		MEMCPY_BCOPY(digest[l], context[l].state, SHA256_DIGEST_LENGTH);
+	}
+
+	/* Clean up state data: */
+	memzero(context, sizeof(context));
+	memzero(state, sizeof(state));
+	memzero(block, sizeof(block));
+}
+
+/* Lane count requested with sha256_set_lanes, 0 meaning automatic. */
+static size_t sha256_requested_lanes = 0;
+
+#ifdef SHA2_MULTI_BUFFER
+/*
+ * Whether the eight-lane AVX2 code can run, or -1 until the first call
+ * probes the CPU.  Cached like the selected backend so that each batch
+ * does not run CPUID and xgetbv again.
+ */
+static int sha256_avx2_supported = -1;
+
+static int sha256_has_avx2(void) {
+	int supported = SHA2_LOAD_RELAXED(&sha256_avx2_supported);
+	if (supported < 0) {
+		supported = sha256_backend_supported(SHA256_BACKEND_AVX2);
+		SHA2_STORE_RELAXED(&sha256_avx2_supported, supported);
+	}
+	return supported;
+}
+#endif
+
+int sha256_set_lanes(size_t lanes) {
+	switch (lanes) {
+	case 0:
+	case 1:
+		break;
+#ifdef SHA2_MULTI_BUFFER
+	case 4:
+		break;
+	case 8:
+		if (!sha256_has_avx2()) {
+			return 0;
+		}
+		break;
+#endif
+	default:
+		return 0;
+	}
+	SHA2_STORE_RELAXED(&sha256_requested_lanes, lanes);
+	return 1;
+}
+
+size_t sha256_get_lanes(void) {
+	size_t lanes = SHA2_LOAD_RELAXED(&sha256_requested_lanes);
+	if (lanes != 0) {
+		return lanes;
+	}
+#ifdef SHA2_MULTI_BUFFER
+	/* One SHA-NI stream outruns the vector lanes */
+	if (sha256_get_backend() == SHA256_BACKEND_SHANI) {
+		return 1;
+	}
+	return sha256_has_avx2() ? 8 : 4;
+#else
+	return 1;
+#endif
+}
+
+void sha256_Raw_xN(const sha2_byte* const data[], const size_t len[], size_t count, sha2_byte* const digest[]) {
+	size_t				lanes = sha256_get_lanes(), i, group;
+	sha256_transform_xn_function	transform = 0;
+
+#ifdef SHA2_MULTI_BUFFER
+	if (lanes == 8) {
+		transform = sha256_Transform_x8_avx2;
+	} else if (lanes == 4) {
+		transform = sha256_Transform_x4_sse2;
+	}
+#endif
+	for (i = 0; i < count; i += group) {
+		group = count - i < lanes ? count - i : lanes;
+		if (group == 1 || transform == 0) {
+			group = 1;
+			sha256_Raw(data[i], len[i], digest[i]);
+		} else {
+			sha256_Raw_group(data + i, len + i, group, digest + i, lanes, transform);
+		}
+	}
+}
+
 char* sha256_Data(const sha2_byte* data, size_t len, char digest[SHA256_DIGEST_STRING_LENGTH]) {
 	SHA256_CTX	context;
 
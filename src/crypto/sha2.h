@@ -44,6 +44,7 @@ extern "C" {
 #define SHA256_BLOCK_LENGTH		64
 #define SHA256_DIGEST_LENGTH		32
 #define SHA256_DIGEST_STRING_LENGTH	(SHA256_DIGEST_LENGTH * 2 + 1)
+#define SHA256_MAX_LANES		8
 #define SHA512_BLOCK_LENGTH		128
 #define SHA512_DIGEST_LENGTH		64
 #define SHA512_DIGEST_STRING_LENGTH	(SHA512_DIGEST_LENGTH * 2 + 1)
@@ -90,6 +91,23 @@ typedef struct _SHA512_CTX {
 }
 #endif /* BYTE_ORDER == LITTLE_ENDIAN */
 
+/*** SHA-256 BACKENDS *************************************************/
+/*
+ * sha256_Transform runs on the fastest backend the CPU supports unless
+ * another one is selected with sha256_set_backend.  All backends produce
+ * identical results.
+ */
+typedef enum {
+	SHA256_BACKEND_AUTO = 0,	/* Best backend supported by the CPU */
+	SHA256_BACKEND_PORTABLE,	/* Portable C */
+	SHA256_BACKEND_AVX2,		/* AVX2 message schedule, BMI2 rounds */
+	SHA256_BACKEND_SHANI		/* x86 SHA extensions */
+} sha256_backend;
+
+int sha256_backend_supported(sha256_backend backend);
+sha256_backend sha256_get_backend(void);
+int sha256_set_backend(sha256_backend backend);
+
 extern const uint32_t sha256_initial_hash_value[8];
 extern const uint64_t sha512_initial_hash_value[8];
 
@@ -109,6 +127,16 @@ char* sha256_End(SHA256_CTX*, char[SHA256_DIGEST_STRING_LENGTH]);
 void sha256_Raw(const uint8_t*, size_t, uint8_t[SHA256_DIGEST_LENGTH]);
 char* sha256_Data(const uint8_t*, size_t, char[SHA256_DIGEST_STRING_LENGTH]);
 
+/*
+ * Hashes count independent messages, data[i] of len[i] bytes into
+ * digest[i], running up to SHA256_MAX_LANES compressions in parallel.
+ * sha256_set_lanes forces 1, 4 (SSE2) or 8 (AVX2) lanes, 0 restoring
+ * the automatic choice; it returns 0 if the CPU cannot run that many.
+ */
+void sha256_Raw_xN(const uint8_t* const data[], const size_t len[], size_t count, uint8_t* const digest[]);
+int sha256_set_lanes(size_t lanes);
+size_t sha256_get_lanes(void);
+
 void sha512_Transform(const uint64_t* state_in, const uint64_t* data, uint64_t* state_out);
 void sha512_Init(SHA512_CTX*);
 void sha512_Update(SHA512_CTX*, const uint8_t*, size_t);
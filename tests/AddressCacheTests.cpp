@@ -0,0 +1,95 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "AddressCache.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Binance {
+
+static std::string encode(AddressCache& cache, Network network, const Data& keyHash) {
+    char out[Bech32::maxLength];
+    return std::string(out, cache.encode(out, network, keyHash.data(), keyHash.size()));
+}
+
+TEST(BinanceAddressCache, Encode) {
+    AddressCache cache(16);
+    const auto keyHash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+    for (auto i = 0; i < 2; i += 1) {
+        ASSERT_EQ(encode(cache, Network::mainnet, keyHash), "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu");
+        ASSERT_EQ(encode(cache, Network::testnet, keyHash), "tbnb1hgm0p7khfk85zpz5v0j8wnej3a90w709zzlffd");
+    }
+    ASSERT_EQ(cache.misses(), 2);
+    ASSERT_EQ(cache.hits(), 2);
+
+    // Other sizes bypass the cache
+    const auto longer = Data(32, 7);
+    ASSERT_EQ(encode(cache, Network::mainnet, longer), Address(Address::binanceHRP, longer).encode());
+    ASSERT_EQ(encode(cache, Network::mainnet, Data(1)), "");
+    ASSERT_EQ(cache.misses() + cache.hits(), 4);
+}
+
+TEST(BinanceAddressCache, Eviction) {
+    AddressCache cache(3);
+    ASSERT_EQ(cache.capacity(), 4);
+
+    // Five key hashes cannot all stay in four slots
+    std::vector<Data> keyHashes;
+    for (auto i = 0; i < 5; i += 1) {
+        keyHashes.push_back(Data(20, static_cast<byte>(i)));
+        ASSERT_EQ(encode(cache, Network::mainnet, keyHashes.back()), Address(Address::binanceHRP, keyHashes.back()).encode());
+    }
+    ASSERT_EQ(cache.misses(), 5);
+    ASSERT_EQ(encode(cache, Network::mainnet, keyHashes.back()), Address(Address::binanceHRP, keyHashes.back()).encode());
+    ASSERT_EQ(cache.hits(), 1);
+    for (const auto& keyHash : keyHashes) {
+        ASSERT_EQ(encode(cache, Network::mainnet, keyHash), Address(Address::binanceHRP, keyHash).encode());
+    }
+    ASSERT_LT(cache.hits(), 6);
+    ASSERT_GT(cache.misses(), 5);
+
+    const auto first = keyHashes.front();
+    AddressCache disabled(0);
+    ASSERT_EQ(encode(disabled, Network::mainnet, first), Address(Address::binanceHRP, first).encode());
+    ASSERT_EQ(disabled.misses() + disabled.hits(), 0);
+}
+
+TEST(BinanceAddressCache, Threads) {
+    AddressCache cache(8);
+    std::vector<Data> keyHashes;
+    std::vector<std::string> expected;
+    for (auto i = 0; i < 64; i += 1) {
+        keyHashes.push_back(Data(20, static_cast<byte>(i)));
+        expected.push_back(Address(i % 2 == 0 ? Address::binanceHRP : Address::binanceTestHRP, keyHashes.back()).encode());
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4);
+    for (auto t = 0; t < 4; t += 1) {
+        threads.emplace_back([&, t] {
+            for (auto round = 0; round < 1000; round += 1) {
+                const auto i = (round * 7 + t) % keyHashes.size();
+                const auto network = i % 2 == 0 ? Network::mainnet : Network::testnet;
+                failures[t] += encode(cache, network, keyHashes[i]) != expected[i];
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto failure : failures) {
+        ASSERT_EQ(failure, 0);
+    }
+    ASSERT_EQ(cache.hits() + cache.misses(), 4000);
+}
+
+} // namespace
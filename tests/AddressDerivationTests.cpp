@@ -0,0 +1,127 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "AddressDerivation.h"
+#include "Bech32.h"
+#include "HexCoding.h"
+#include "SigningKey.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/secp256k1.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+
+namespace Binance {
+
+TEST(BinanceAddressDerivation, Derive) {
+    const auto result = deriveAddresses({parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9")});
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_EQ(hex(result[0].publicKey.begin(), result[0].publicKey.end()), "029729a52e4e3c2b4a4e52aa74033eedaf8ba1df5ab6d1f518fd69e67bbd309b0e");
+    ASSERT_EQ(result[0].address, "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu");
+}
+
+TEST(BinanceAddressDerivation, MatchesSigningKey) {
+    std::mt19937 random(19);
+    std::vector<Data> privateKeys(300, Data(32));
+    for (auto& privateKey : privateKeys) {
+        for (auto& byte : privateKey) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+    // Keys at the bottom and top of the valid range
+    privateKeys[7] = parse_hex("0000000000000000000000000000000000000000000000000000000000000001");
+    privateKeys[8] = parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140");
+
+    for (auto threads : {1u, 3u}) {
+        const auto result = deriveAddresses(privateKeys, Address::binanceTestHRP, threads);
+        ASSERT_EQ(result.size(), privateKeys.size());
+        for (std::size_t i = 0; i < privateKeys.size(); i += 1) {
+            const auto key = SigningKey(privateKeys[i], Address::binanceTestHRP);
+            ASSERT_EQ(result[i].publicKey, key.publicKey) << i;
+            ASSERT_EQ(result[i].address, key.address) << i;
+        }
+    }
+}
+
+TEST(BinanceAddressDerivation, Invalid) {
+    ASSERT_TRUE(deriveAddresses({}).empty());
+    ASSERT_THROW(deriveAddresses({Data(32)}), std::invalid_argument);
+    ASSERT_THROW(deriveAddresses({parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9"), Data(31, 1)}), std::invalid_argument);
+    ASSERT_THROW(deriveAddresses({Data(32, 1)}, ""), std::invalid_argument);
+    ASSERT_THROW(deriveAddresses({Data(32, 1)}, "bnb b"), std::invalid_argument);
+}
+
+TEST(BinanceAddressDerivation, Recover) {
+    std::mt19937 random(23);
+    std::vector<Data> privateKeys(150, Data(32));
+    std::vector<RecoverableSignature> signatures(privateKeys.size());
+    for (std::size_t i = 0; i < privateKeys.size(); i += 1) {
+        auto& signature = signatures[i];
+        signature.signature.resize(64);
+        signature.digest.resize(32);
+        for (auto& byte : privateKeys[i]) {
+            byte = static_cast<uint8_t>(random());
+        }
+        for (auto& byte : signature.digest) {
+            byte = static_cast<uint8_t>(random());
+        }
+        uint8_t recoveryId;
+        ASSERT_EQ(ecdsa_sign_digest(&secp256k1, privateKeys[i].data(), signature.digest.data(), signature.signature.data(), &recoveryId, nullptr), 0);
+        signature.recoveryId = recoveryId;
+    }
+    // No point with x = r + n on the curve
+    signatures[3].recoveryId |= 2;
+    // r out of range
+    std::fill(signatures[4].signature.begin(), signatures[4].signature.begin() + 32, 0xff);
+
+    for (auto threads : {1u, 3u}) {
+        const auto result = recoverAddresses(signatures, Address::binanceHRP, threads);
+        ASSERT_EQ(result.size(), signatures.size());
+        for (std::size_t i = 0; i < signatures.size(); i += 1) {
+            if (i == 3 || i == 4) {
+                ASSERT_TRUE(result[i].publicKey.empty()) << i;
+                ASSERT_TRUE(result[i].address.empty()) << i;
+                continue;
+            }
+            const auto key = SigningKey(privateKeys[i]);
+            ASSERT_EQ(result[i].publicKey, key.publicKey) << i;
+            ASSERT_EQ(result[i].address, key.address) << i;
+        }
+    }
+
+    ASSERT_TRUE(recoverAddresses({}).empty());
+    auto malformed = signatures[0];
+    malformed.recoveryId = 4;
+    ASSERT_THROW(recoverAddresses({malformed}), std::invalid_argument);
+    malformed = signatures[0];
+    malformed.digest.pop_back();
+    ASSERT_THROW(recoverAddresses({malformed}), std::invalid_argument);
+    ASSERT_THROW(recoverAddresses({signatures[0]}, ""), std::invalid_argument);
+}
+
+TEST(BinanceAddressDerivation, Bech32FixedBuffer) {
+    const auto keyHash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+    Data values;
+    Bech32::convertBits<8, 5, true>(values, keyHash);
+
+    char out[Bech32::maxLength];
+    const auto length = Bech32::encode(out, "bnb", 3, keyHash.data(), keyHash.size());
+    ASSERT_EQ(std::string(out, length), Bech32::encode("bnb", values));
+    ASSERT_EQ(std::string(out, length), "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu");
+
+    ASSERT_EQ(Bech32::encode(out, "", 0, keyHash.data(), keyHash.size()), 0);
+    ASSERT_EQ(Bech32::encode(out, "BNB", 3, keyHash.data(), keyHash.size()), 0);
+    const Data longest(50);
+    ASSERT_EQ(Bech32::encode(out, "bnb", 3, longest.data(), longest.size()), Bech32::maxLength);
+    const Data tooLong(51);
+    ASSERT_EQ(Bech32::encode(out, "bnb", 3, tooLong.data(), tooLong.size()), 0);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Address.h"
+#include "Bech32.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace Binance {
+
+TEST(BinanceAddress, Bech32DecodeFixedBuffer) {
+    const std::vector<std::string> strings = {
+        "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu",
+        "tbnb1hgm0p7khfk85zpz5v0j8wnej3a90w709zzlffd",
+        "BNB1HGM0P7KHFK85ZPZ5V0J8WNEJ3A90W709VHKDFU",
+        // BIP 173 vectors
+        "A12UEL5L",
+        "an83characterlonghumanreadablepartthatcontainsthenumber1andtheexcludedcharactersbio1tt5tgs",
+        "abcdef1qpzry9x8gf2tvdw0s3jn54khce6mua7lmqqqxw",
+        "split1checkupstagehandshakeupstreamerranterredcaperred2y9e3w",
+        // mixed case, bad checksum, no separator, empty HRP, too long, invalid character
+        "bnb1HGM0P7KHFK85ZPZ5V0J8WNEJ3A90W709VHKDFU",
+        "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfv",
+        "bnbhgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu",
+        "1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu",
+        "an84characterslonghumanreadablepartthatcontainsthenumber1andtheexcludedcharactersbio1569pvx",
+        "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdbu",
+    };
+    for (const auto& string : strings) {
+        const auto expected = Bech32::decode(string);
+        Data expectedData;
+        const auto converted = Bech32::convertBits<5, 8, false>(expectedData, expected.second);
+
+        char hrp[Bech32::maxLength];
+        uint8_t data[Bech32::maxLength];
+        std::size_t hrpLength = 0, size = 0;
+        const auto decoded = Bech32::decode(string.data(), string.size(), hrp, hrpLength, data, size);
+        ASSERT_EQ(decoded, !expected.first.empty() && converted) << string;
+        if (!decoded) {
+            continue;
+        }
+        ASSERT_EQ(std::string(hrp, hrpLength), expected.first);
+        ASSERT_EQ(Data(data, data + size), expectedData);
+    }
+}
+
+TEST(BinanceAddress, EncodeDecode) {
+    const auto keyHash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+    ASSERT_EQ(Address(Address::binanceHRP, keyHash).encode(), "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu");
+    ASSERT_EQ(Address(Address::binanceTestHRP, keyHash).encode(), "tbnb1hgm0p7khfk85zpz5v0j8wnej3a90w709zzlffd");
+
+    const auto decoded = Address::decode("BNB1HGM0P7KHFK85ZPZ5V0J8WNEJ3A90W709VHKDFU");
+    ASSERT_TRUE(decoded.second);
+    ASSERT_EQ(decoded.first.hrp, Address::binanceHRP);
+    ASSERT_EQ(decoded.first.keyHash, keyHash);
+
+    // Only Binance prefixes and key hashes of 2 to 40 bytes
+    ASSERT_EQ(Address("cosmos", keyHash).encode(), "");
+    ASSERT_EQ(Address(Address::binanceHRP, Data(1)).encode(), "");
+    ASSERT_EQ(Address(Address::binanceHRP, Data(41)).encode(), "");
+    const auto longest = Address(Address::binanceTestHRP, Data(40, 7));
+    ASSERT_EQ(Address::decode(longest.encode()).first, longest);
+    ASSERT_FALSE(Address::decode(Bech32::encode("cosmos", {23, 8, 27, 15})).second);
+    ASSERT_FALSE(Address::decode("bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfv").second);
+}
+
+} // namespace
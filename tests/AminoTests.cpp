@@ -0,0 +1,139 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "Amino.h"
+#include "HexCoding.h"
+#include "Signer.h"
+
+#include "dex.pb.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <gtest/gtest.h>
+
+namespace Binance {
+
+// Wraps protobuf output the way `Signer` did before the single-pass encoder.
+static Data referenceWrap(const std::string& raw, const Data& typePrefix, bool prefixWithSize) {
+    std::string msg;
+    {
+        google::protobuf::io::StringOutputStream output(&msg);
+        google::protobuf::io::CodedOutputStream cos(&output);
+        if (prefixWithSize) {
+            cos.WriteVarint64(raw.size() + typePrefix.size());
+        }
+        cos.WriteRaw(typePrefix.data(), typePrefix.size());
+        cos.WriteRaw(raw.data(), raw.size());
+    }
+    return Data(msg.begin(), msg.end());
+}
+
+static Data referenceTransaction(const Signer& signer, const Data& typePrefix, const Data& signature, const Data& aminoPublicKey) {
+    auto msg = referenceWrap(signer.order.SerializeAsString(), typePrefix, false);
+
+    auto object = Binance::Signature();
+    object.set_pub_key(aminoPublicKey.data(), aminoPublicKey.size());
+    object.set_signature(signature.data(), signature.size());
+    object.set_account_number(signer.accountNumber);
+    object.set_sequence(signer.sequence);
+    auto encodedSignature = referenceWrap(object.SerializeAsString(), {}, false);
+
+    auto transaction = Binance::Transaction();
+    transaction.add_msgs(msg.data(), msg.size());
+    transaction.add_signatures(encodedSignature.data(), encodedSignature.size());
+    transaction.set_memo(signer.memo);
+    transaction.set_source(signer.source);
+    return referenceWrap(transaction.SerializeAsString(), { 0xF0, 0x62, 0x5D, 0xEE }, true);
+}
+
+static void expectEncoding(const ::google::protobuf::Message& order, const Data& typePrefix) {
+    const auto publicKey = parse_hex("029729a52e4e3c2b4a4e52aa74033eedaf8ba1df5ab6d1f518fd69e67bbd309b0e");
+    const auto aminoPublicKey = Amino::encodePublicKey(publicKey);
+    ASSERT_EQ(hex(aminoPublicKey), "eb5ae987" "21" + hex(publicKey));
+
+    EXPECT_EQ(hex(Amino::encodeOrder(order)), hex(referenceWrap(order.SerializeAsString(), typePrefix, false)));
+
+    auto signer = Signer(order);
+    const auto signature = Data(64, 0xA5);
+    EXPECT_EQ(hex(Amino::encodeTransaction(signer, signature, aminoPublicKey)), hex(referenceTransaction(signer, typePrefix, signature, aminoPublicKey)));
+
+    signer.accountNumber = -1;
+    signer.sequence = 300;
+    signer.source = -2;
+    signer.memo = std::string(200, 'm');
+    EXPECT_EQ(hex(Amino::encodeTransaction(signer, signature, aminoPublicKey)), hex(referenceTransaction(signer, typePrefix, signature, aminoPublicKey)));
+    EXPECT_EQ(hex(Amino::encodeTransaction(signer, {}, {})), hex(referenceTransaction(signer, typePrefix, {}, {})));
+}
+
+static const auto keyhash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+
+TEST(BinanceAmino, NewOrder) {
+    auto order = NewOrder();
+    expectEncoding(order, { 0xCE, 0x6D, 0xC0, 0x43 });
+
+    order.set_sender(keyhash.data(), keyhash.size());
+    order.set_id("BA36F0FAD74D8F41045463E4774F328F4AF779E5-36");
+    order.set_symbol("NNB-338_BNB");
+    order.set_ordertype(2);
+    order.set_side(-1);
+    order.set_price(136350000);
+    order.set_quantity(INT64_MAX);
+    order.set_timeinforce(INT64_MIN);
+    expectEncoding(order, { 0xCE, 0x6D, 0xC0, 0x43 });
+}
+
+TEST(BinanceAmino, CancelOrder) {
+    auto order = CancelOrder();
+    order.set_sender(keyhash.data(), keyhash.size());
+    order.set_symbol("NNB-338_BNB");
+    order.set_refid("BA36F0FAD74D8F41045463E4774F328F4AF779E5-29");
+    expectEncoding(order, { 0x16, 0x6E, 0x68, 0x1B });
+}
+
+TEST(BinanceAmino, Send) {
+    auto order = Send();
+    expectEncoding(order, { 0x2A, 0x2C, 0x87, 0xFA });
+
+    for (auto i = 0; i < 12; i += 1) {
+        auto input = order.add_inputs();
+        input->set_address(keyhash.data(), keyhash.size());
+        for (auto j = 0; j < i; j += 1) {
+            auto coin = input->add_coins();
+            coin->set_denom(j % 2 ? "BNB" : "");
+            coin->set_amount(int64_t(1'001'000'000) * j);
+        }
+        auto output = order.add_outputs();
+        if (i % 3) {
+            output->set_address(keyhash.data(), keyhash.size());
+        }
+        auto coin = output->add_coins();
+        coin->set_denom("NNB-338");
+        coin->set_amount(-i);
+    }
+    expectEncoding(order, { 0x2A, 0x2C, 0x87, 0xFA });
+}
+
+TEST(BinanceAmino, Freeze) {
+    auto freeze = TokenFreeze();
+    freeze.set_from(keyhash.data(), keyhash.size());
+    freeze.set_symbol("NNB-338");
+    freeze.set_amount(100000000);
+    expectEncoding(freeze, { 0xE7, 0x74, 0xB3, 0x2D });
+
+    auto unfreeze = TokenUnfreeze();
+    unfreeze.set_from(keyhash.data(), keyhash.size());
+    unfreeze.set_symbol("NNB-338");
+    expectEncoding(unfreeze, { 0x65, 0x15, 0xFF, 0x0D });
+}
+
+TEST(BinanceAmino, NotAnOrder) {
+    auto transaction = Transaction();
+    ASSERT_TRUE(Amino::encodeOrder(transaction).empty());
+    ASSERT_TRUE(Amino::encodeTransaction(Signer(transaction), Data(64), Data(38)).empty());
+}
+
+} // namespace
@@ -0,0 +1,99 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "CompactAddress.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace Binance {
+
+static const auto keyHashHex = std::string("ba36f0fad74d8f41045463e4774f328f4af779e5");
+
+static std::array<uint8_t, CompactAddress::size> keyHashBytes(const std::string& string) {
+    const auto data = parse_hex(string);
+    std::array<uint8_t, CompactAddress::size> result;
+    std::copy(data.begin(), data.end(), result.begin());
+    return result;
+}
+
+TEST(BinanceCompactAddress, EncodeDecode) {
+    const auto address = CompactAddress(Network::mainnet, keyHashBytes(keyHashHex));
+    ASSERT_EQ(address.encode(), "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu");
+    ASSERT_EQ(CompactAddress(Network::testnet, address.keyHash).encode(), "tbnb1hgm0p7khfk85zpz5v0j8wnej3a90w709zzlffd");
+
+    const auto decoded = CompactAddress::decode("tbnb1hgm0p7khfk85zpz5v0j8wnej3a90w709zzlffd");
+    ASSERT_TRUE(decoded.second);
+    ASSERT_EQ(decoded.first.network, Network::testnet);
+    ASSERT_EQ(decoded.first.keyHash, address.keyHash);
+
+    // Other prefixes, key hashes of other lengths and bad checksums
+    ASSERT_FALSE(CompactAddress::decode(Address(Address::binanceHRP, Data(32, 1)).encode()).second);
+    ASSERT_FALSE(CompactAddress::decode(Bech32::encode("cosmos", {23, 8, 27, 15})).second);
+    ASSERT_FALSE(CompactAddress::decode("bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfv").second);
+}
+
+TEST(BinanceCompactAddress, ConvertAddress) {
+    const auto address = Address(Address::binanceTestHRP, parse_hex(keyHashHex));
+    const auto compact = CompactAddress::fromAddress(address);
+    ASSERT_TRUE(compact.second);
+    ASSERT_EQ(compact.first.network, Network::testnet);
+    ASSERT_EQ(compact.first.toAddress(), address);
+    ASSERT_EQ(compact.first.encode(), address.encode());
+
+    ASSERT_FALSE(CompactAddress::fromAddress(Address("cosmos", parse_hex(keyHashHex))).second);
+    ASSERT_FALSE(CompactAddress::fromAddress(Address(Address::binanceHRP, Data(19))).second);
+}
+
+TEST(BinanceCompactAddress, OrderAndHash) {
+    const auto low = CompactAddress(Network::mainnet, keyHashBytes("00000000000000000000000000000000000000ff"));
+    const auto high = CompactAddress(Network::mainnet, keyHashBytes("0100000000000000000000000000000000000000"));
+    const auto test = CompactAddress(Network::testnet, low.keyHash);
+    ASSERT_TRUE(low < high);
+    ASSERT_TRUE(high < test);
+    ASSERT_TRUE(low <= low && low >= low && test > low);
+    ASSERT_TRUE(low != test);
+    ASSERT_EQ(low, CompactAddress(Network::mainnet, low.keyHash));
+    ASSERT_NE(std::hash<CompactAddress>()(low), std::hash<CompactAddress>()(test));
+
+    // Key hashes that differ only after their leading 8 bytes still spread over the buckets
+    std::set<std::size_t> hashes;
+    for (auto i = 0; i < 256; i += 1) {
+        auto keyHash = low.keyHash;
+        keyHash[12 + i % 8] = static_cast<uint8_t>(i);
+        hashes.insert(std::hash<CompactAddress>()(CompactAddress(Network::mainnet, keyHash)) % 1024);
+    }
+    ASSERT_GT(hashes.size(), 200u);
+
+    // Trading multiples of public constants between words, which collides any unkeyed linear hash
+    auto shifted = low.keyHash;
+    uint64_t words[2];
+    std::memcpy(words, shifted.data(), sizeof(words));
+    words[0] += 0xd6e8feb86659fd93;
+    words[1] -= 0x9e3779b97f4a7c15;
+    std::memcpy(shifted.data(), words, sizeof(words));
+    ASSERT_NE(std::hash<CompactAddress>()(low), std::hash<CompactAddress>()(CompactAddress(Network::mainnet, shifted)));
+
+    std::unordered_map<CompactAddress, int> balances;
+    balances[low] += 1;
+    balances[test] += 2;
+    balances[low] += 3;
+    ASSERT_EQ(balances.size(), 2u);
+    ASSERT_EQ(balances[low], 4);
+
+    const std::set<CompactAddress> ordered = {test, high, low};
+    ASSERT_EQ(std::vector<CompactAddress>(ordered.begin(), ordered.end()), (std::vector<CompactAddress>{low, high, test}));
+}
+
+} // namespace
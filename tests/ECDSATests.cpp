@@ -0,0 +1,263 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "crypto/ecdsa.h"
+#include "crypto/secp256k1.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace Binance {
+
+using Bytes = std::array<uint8_t, 32>;
+
+// The affine verification that ecdsa_verify_digest did before it moved to
+// a Jacobian dual multiplication: 0 for a valid signature.
+static int referenceVerify(const uint8_t* publicKey, const uint8_t* signature, const uint8_t* digest) {
+    curve_point pub, res;
+    if (!ecdsa_read_pubkey(&secp256k1, publicKey, &pub)) {
+        return 1;
+    }
+    bignum256 r, s, z;
+    bn_read_be(signature, &r);
+    bn_read_be(signature + 32, &s);
+    bn_read_be(digest, &z);
+    if (bn_is_zero(&r) || bn_is_zero(&s) || !bn_is_less(&r, &secp256k1.order) || !bn_is_less(&s, &secp256k1.order)) {
+        return 2;
+    }
+    bn_inverse(&s, &secp256k1.order);
+    bn_multiply(&s, &z, &secp256k1.order);
+    bn_mod(&z, &secp256k1.order);
+    bn_multiply(&r, &s, &secp256k1.order);
+    bn_mod(&s, &secp256k1.order);
+    if (bn_is_zero(&z)) {
+        return 3;
+    }
+    scalar_multiply(&secp256k1, &z, &res);
+    point_multiply(&secp256k1, &s, &pub, &pub);
+    point_add(&secp256k1, &pub, &res);
+    bn_mod(&res.x, &secp256k1.order);
+    return bn_is_equal(&res.x, &r) ? 0 : 5;
+}
+
+static Bytes randomBytes(std::mt19937& random) {
+    Bytes bytes;
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(random());
+    }
+    return bytes;
+}
+
+TEST(BinanceECDSA, VerifyMatchesReference) {
+    std::mt19937 random(31);
+    for (auto round = 0; round < 40; round += 1) {
+        const auto privateKey = randomBytes(random);
+        auto digest = randomBytes(random);
+        uint8_t compressed[33], uncompressed[65], signature[64];
+        ecdsa_get_public_key33(&secp256k1, privateKey.data(), compressed);
+        ecdsa_get_public_key65(&secp256k1, privateKey.data(), uncompressed);
+        ASSERT_EQ(ecdsa_sign_digest(&secp256k1, privateKey.data(), digest.data(), signature, nullptr, nullptr), 0);
+
+        ASSERT_EQ(ecdsa_verify_digest(&secp256k1, compressed, signature, digest.data()), 0);
+        ASSERT_EQ(ecdsa_verify_digest(&secp256k1, uncompressed, signature, digest.data()), 0);
+        ASSERT_EQ(referenceVerify(compressed, signature, digest.data()), 0);
+
+        // Tampered digests and signatures
+        digest[random() % 32] ^= 1 << (random() % 8);
+        ASSERT_EQ(ecdsa_verify_digest(&secp256k1, compressed, signature, digest.data()), referenceVerify(compressed, signature, digest.data()));
+        ASSERT_NE(ecdsa_verify_digest(&secp256k1, compressed, signature, digest.data()), 0);
+        signature[random() % 64] ^= 1 << (random() % 8);
+        ASSERT_EQ(ecdsa_verify_digest(&secp256k1, compressed, signature, digest.data()), referenceVerify(compressed, signature, digest.data()));
+    }
+}
+
+TEST(BinanceECDSA, VerifyEdgeCases) {
+    // With the generator as public key, u1 * G + u2 * G collapses:
+    // r = -z gives the point at infinity and r = z doubles u1 * G.
+    Bytes one{};
+    one[31] = 1;
+    uint8_t publicKey[33];
+    ecdsa_get_public_key33(&secp256k1, one.data(), publicKey);
+
+    std::mt19937 random(37);
+    for (auto round = 0; round < 10; round += 1) {
+        auto digest = randomBytes(random);
+        digest[0] &= 0x7f;
+        bignum256 z, r;
+        bn_read_be(digest.data(), &z);
+
+        uint8_t signature[64];
+        auto s = randomBytes(random);
+        s[0] &= 0x7f;
+        std::copy(s.begin(), s.end(), signature + 32);
+
+        bn_subtract(&secp256k1.order, &z, &r);
+        bn_write_be(&r, signature);
+        ASSERT_EQ(ecdsa_verify_digest(&secp256k1, publicKey, signature, digest.data()), 5);
+        ASSERT_EQ(referenceVerify(publicKey, signature, digest.data()), 5);
+
+        std::copy(digest.begin(), digest.end(), signature);
+        ASSERT_EQ(ecdsa_verify_digest(&secp256k1, publicKey, signature, digest.data()), referenceVerify(publicKey, signature, digest.data()));
+    }
+
+    // A digest of zero
+    uint8_t signature[64];
+    const auto privateKey = randomBytes(random);
+    Bytes digest{};
+    ecdsa_get_public_key33(&secp256k1, privateKey.data(), publicKey);
+    ASSERT_EQ(ecdsa_sign_digest(&secp256k1, privateKey.data(), digest.data(), signature, nullptr, nullptr), 0);
+    ASSERT_EQ(ecdsa_verify_digest(&secp256k1, publicKey, signature, digest.data()), 3);
+}
+
+TEST(BinanceECDSA, ScalarMultiplyComb) {
+    std::mt19937 random(37);
+    std::vector<bignum256> scalars(20);
+    for (auto& k : scalars) {
+        const auto bytes = randomBytes(random);
+        bn_read_be(bytes.data(), &k);
+        bn_mod(&k, &secp256k1.order);
+    }
+    bn_zero(&scalars[0]);
+    bn_one(&scalars[1]);
+    bn_subtract(&secp256k1.order, &scalars[1], &scalars[2]);
+    bn_read_uint32(2, &scalars[3]);
+
+    for (auto window = ECDSA_COMB_MIN_WINDOW; window <= ECDSA_COMB_MAX_WINDOW; window += 1) {
+        std::vector<fe_curve_point> table(ECDSA_COMB_SIZE(window));
+        ecdsa_comb_init(&secp256k1, window, table.data());
+        const ecdsa_comb comb = {window, table.data()};
+        for (const auto& k : scalars) {
+            curve_point expected, result;
+            point_multiply(&secp256k1, &k, &secp256k1.G, &expected);
+            scalar_multiply_comb(&secp256k1, &comb, &k, &result);
+            ASSERT_TRUE(point_is_equal(&result, &expected)) << "window " << window;
+        }
+    }
+}
+
+TEST(BinanceECDSA, ScalarMultiplyBatchLanes) {
+    std::mt19937 random(41);
+    // Full groups of four lanes, a partial group and a zero scalar in a lane
+    const std::size_t count = 23;
+    std::vector<bignum256> scalars(count);
+    for (auto& k : scalars) {
+        const auto bytes = randomBytes(random);
+        bn_read_be(bytes.data(), &k);
+        bn_mod(&k, &secp256k1.order);
+    }
+    bn_zero(&scalars[1]);
+    bn_one(&scalars[4]);
+    bn_subtract(&secp256k1.order, &scalars[4], &scalars[5]);
+    bn_read_uint32(2, &scalars[21]);
+
+    for (std::size_t lanes : {1, 4}) {
+        if (!ecdsa_set_batch_lanes(lanes)) {
+            continue;
+        }
+        std::vector<curve_point> results(count);
+        scalar_multiply_batch(&secp256k1, scalars.data(), results.data(), count);
+        for (std::size_t i = 0; i < count; i += 1) {
+            curve_point expected;
+            scalar_multiply(&secp256k1, &scalars[i], &expected);
+            ASSERT_TRUE(point_is_equal(&results[i], &expected)) << "lanes " << lanes << " scalar " << i;
+        }
+    }
+    ecdsa_set_batch_lanes(0);
+    ASSERT_FALSE(ecdsa_set_batch_lanes(3));
+}
+
+TEST(BinanceECDSA, SignBatchMatchesSingle) {
+    std::mt19937 random(47);
+    // More than one group of SCALAR_MULTIPLY_BATCH signatures
+    const std::size_t count = 45;
+    std::vector<uint8_t> privateKeys, digests;
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto privateKey = randomBytes(random);
+        const auto digest = randomBytes(random);
+        privateKeys.insert(privateKeys.end(), privateKey.begin(), privateKey.end());
+        digests.insert(digests.end(), digest.begin(), digest.end());
+    }
+
+    std::vector<uint8_t> signatures(64 * count), recovery(count);
+    ASSERT_EQ(ecdsa_sign_digest_batch(&secp256k1, privateKeys.data(), digests.data(), count, signatures.data(), recovery.data()), 0);
+    for (std::size_t i = 0; i < count; i += 1) {
+        uint8_t expected[64], by;
+        ASSERT_EQ(ecdsa_sign_digest(&secp256k1, &privateKeys[32 * i], &digests[32 * i], expected, &by, nullptr), 0);
+        ASSERT_EQ(std::vector<uint8_t>(expected, expected + 64), std::vector<uint8_t>(&signatures[64 * i], &signatures[64 * i] + 64));
+        ASSERT_EQ(recovery[i], by);
+    }
+}
+
+TEST(BinanceECDSA, VerifyBatchMatchesSingle) {
+    std::mt19937 random(53);
+    const std::size_t count = 40;
+    std::vector<uint8_t> publicKeys(33 * count), signatures(64 * count), digests;
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto privateKey = randomBytes(random);
+        const auto digest = randomBytes(random);
+        digests.insert(digests.end(), digest.begin(), digest.end());
+        ecdsa_get_public_key33(&secp256k1, privateKey.data(), &publicKeys[33 * i]);
+        ecdsa_sign_digest(&secp256k1, privateKey.data(), digest.data(), &signatures[64 * i], nullptr, nullptr);
+    }
+    // wrong digest, wrong key, s out of range, r zero, invalid key
+    digests[32 * 3] ^= 1;
+    std::copy(&publicKeys[33 * 5], &publicKeys[33 * 6], &publicKeys[33 * 4]);
+    std::fill(&signatures[64 * 7 + 32], &signatures[64 * 8], 0xff);
+    std::fill(&signatures[64 * 9], &signatures[64 * 9 + 32], 0);
+    publicKeys[33 * 20] = 0x04;
+    std::fill(&publicKeys[33 * 21 + 1], &publicKeys[33 * 22], 0);
+    publicKeys[33 * 21 + 32] = 5;
+
+    std::vector<int> results(count);
+    ecdsa_verify_digest_batch(&secp256k1, publicKeys.data(), signatures.data(), digests.data(), count, results.data());
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto expected = ecdsa_verify_digest(&secp256k1, &publicKeys[33 * i], &signatures[64 * i], &digests[32 * i]);
+        ASSERT_EQ(results[i], expected) << i;
+    }
+    ASSERT_EQ(std::count(results.begin(), results.end(), 0), static_cast<long>(count) - 6);
+}
+
+TEST(BinanceECDSA, RecoverBatchMatchesSingle) {
+    std::mt19937 random(59);
+    // Every recovery id, so some R points are not on the curve
+    const std::size_t count = 4 * 9;
+    std::vector<uint8_t> signatures(64 * count), digests;
+    std::vector<int> recoveryIds(count);
+    for (std::size_t i = 0; i < count; i += 1) {
+        const auto privateKey = randomBytes(random);
+        const auto digest = randomBytes(random);
+        digests.insert(digests.end(), digest.begin(), digest.end());
+        ecdsa_sign_digest(&secp256k1, privateKey.data(), digest.data(), &signatures[64 * i], nullptr, nullptr);
+        recoveryIds[i] = static_cast<int>(i % 4);
+    }
+    // r zero, s out of range
+    std::fill(&signatures[64 * 5], &signatures[64 * 5 + 32], 0);
+    std::fill(&signatures[64 * 6 + 32], &signatures[64 * 7], 0xff);
+
+    std::vector<uint8_t> publicKeys(33 * count);
+    std::vector<int> results(count);
+    ecdsa_recover_pub_from_sig_batch(&secp256k1, signatures.data(), digests.data(), recoveryIds.data(), count, publicKeys.data(), results.data());
+    std::size_t recovered = 0;
+    for (std::size_t i = 0; i < count; i += 1) {
+        uint8_t expected[65];
+        const auto result = ecdsa_recover_pub_from_sig(&secp256k1, expected, &signatures[64 * i], &digests[32 * i], recoveryIds[i]);
+        ASSERT_EQ(results[i], result) << i;
+        if (result != 0) {
+            continue;
+        }
+        recovered += 1;
+        ASSERT_EQ(publicKeys[33 * i], 0x02 | (expected[64] & 1)) << i;
+        ASSERT_TRUE(std::equal(expected + 1, expected + 33, &publicKeys[33 * i + 1])) << i;
+    }
+    ASSERT_GT(recovered, count / 4);
+}
+
+} // namespace
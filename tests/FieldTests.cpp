@@ -0,0 +1,278 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+
+#include "crypto/bignum.h"
+#include "crypto/secp256k1.h"
+#include "crypto/secp256k1_field.h"
+#include "crypto/secp256k1_field_x4.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Binance {
+
+using Bytes = std::array<uint8_t, 32>;
+
+static secp256k1_fe element(const Bytes& bytes) {
+    secp256k1_fe r;
+    for (auto i = 0; i < 4; i += 1) {
+        r.n[3 - i] = 0;
+        for (auto j = 0; j < 8; j += 1) {
+            r.n[3 - i] = r.n[3 - i] << 8 | bytes[8 * i + j];
+        }
+    }
+    return r;
+}
+
+static std::string toHex(const secp256k1_fe& a) {
+    bignum256 x;
+    secp256k1_fe_get_bn(&x, &a);
+    Bytes bytes;
+    bn_write_be(&x, bytes.data());
+    return hex(bytes.begin(), bytes.end());
+}
+
+static std::string toHex(bignum256 x) {
+    bn_fast_mod(&x, &secp256k1.prime);
+    bn_mod(&x, &secp256k1.prime);
+    Bytes bytes;
+    bn_write_be(&x, bytes.data());
+    return hex(bytes.begin(), bytes.end());
+}
+
+static bignum256 reference(const Bytes& bytes) {
+    bignum256 x;
+    bn_read_be(bytes.data(), &x);
+    bn_mod(&x, &secp256k1.prime);
+    return x;
+}
+
+// Random values plus the ones next to 0, p and 2^256, where the reductions
+// take their rare carries.
+static std::vector<Bytes> values() {
+    std::vector<Bytes> result;
+    Bytes prime;
+    bn_write_be(&secp256k1.prime, prime.data());
+    for (int delta = -2; delta <= 2; delta += 1) {
+        auto value = prime;
+        value[31] += delta;
+        result.push_back(value);
+    }
+    Bytes ones;
+    ones.fill(0xff);
+    result.push_back(ones);
+    ones[31] = 0xfe;
+    result.push_back(ones);
+    result.push_back(Bytes{});
+    Bytes one{};
+    one[31] = 1;
+    result.push_back(one);
+
+    std::mt19937 random(19);
+    while (result.size() < 60) {
+        Bytes value;
+        for (auto& byte : value) {
+            byte = static_cast<uint8_t>(random());
+        }
+        result.push_back(value);
+    }
+    return result;
+}
+
+TEST(BinanceField, MatchesBignum) {
+    const auto all = values();
+    for (const auto& x : all) {
+        const auto a = element(x);
+        const auto ra = reference(x);
+        ASSERT_EQ(toHex(a), toHex(ra));
+
+        secp256k1_fe r;
+        secp256k1_fe_sqr(&r, &a);
+        auto expected = ra;
+        bn_multiply(&ra, &expected, &secp256k1.prime);
+        ASSERT_EQ(toHex(r), toHex(expected)) << "sqr " << hex(x.begin(), x.end());
+
+        secp256k1_fe_half(&r, &a);
+        expected = ra;
+        bn_mult_half(&expected, &secp256k1.prime);
+        ASSERT_EQ(toHex(r), toHex(expected)) << "half " << hex(x.begin(), x.end());
+
+        secp256k1_fe_mul_int(&r, &a, 3);
+        expected = ra;
+        bn_mult_k(&expected, 3, &secp256k1.prime);
+        ASSERT_EQ(toHex(r), toHex(expected)) << "mul_int " << hex(x.begin(), x.end());
+
+        secp256k1_fe_negate(&r, &a);
+        secp256k1_fe_add(&r, &r, &a);
+        ASSERT_TRUE(secp256k1_fe_is_zero(&r));
+
+        for (const auto& y : all) {
+            const auto b = element(y);
+            const auto rb = reference(y);
+
+            secp256k1_fe_mul(&r, &a, &b);
+            expected = rb;
+            bn_multiply(&ra, &expected, &secp256k1.prime);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "mul " << hex(x.begin(), x.end()) << " " << hex(y.begin(), y.end());
+
+            secp256k1_fe_add(&r, &a, &b);
+            expected = ra;
+            bn_addmod(&expected, &rb, &secp256k1.prime);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "add " << hex(x.begin(), x.end()) << " " << hex(y.begin(), y.end());
+
+            secp256k1_fe_sub(&r, &a, &b);
+            bn_subtractmod(&ra, &rb, &expected, &secp256k1.prime);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "sub " << hex(x.begin(), x.end()) << " " << hex(y.begin(), y.end());
+        }
+    }
+}
+
+TEST(BinanceField, Inverse) {
+    const auto all = values();
+    std::vector<secp256k1_fe> batch;
+    std::vector<std::string> expected;
+    for (const auto& x : all) {
+        const auto a = element(x);
+        secp256k1_fe r;
+        secp256k1_fe_inv(&r, &a);
+
+        auto ra = reference(x);
+        if (bn_is_zero(&ra)) {
+            ASSERT_TRUE(secp256k1_fe_is_zero(&r));
+            continue;
+        }
+        bn_inverse(&ra, &secp256k1.prime);
+        ASSERT_EQ(toHex(r), toHex(ra)) << hex(x.begin(), x.end());
+        batch.push_back(a);
+        expected.push_back(toHex(ra));
+    }
+
+    std::vector<secp256k1_fe> scratch(batch.size());
+    secp256k1_fe_inv_batch(batch.data(), scratch.data(), batch.size());
+    for (std::size_t i = 0; i < batch.size(); i += 1) {
+        ASSERT_EQ(toHex(batch[i]), expected[i]);
+    }
+}
+
+TEST(BinanceField, InversePow) {
+    for (const auto& x : values()) {
+        const auto a = element(x);
+        secp256k1_fe expected, result;
+        secp256k1_fe_inv(&expected, &a);
+        secp256k1_fe_inv_pow(&result, &a);
+        ASSERT_EQ(toHex(result), toHex(expected)) << hex(x.begin(), x.end());
+    }
+}
+
+TEST(BinanceField, Sqrt) {
+    std::size_t squares = 0;
+    for (const auto& x : values()) {
+        const auto a = element(x);
+        const auto ra = reference(x);
+
+        // every square has a root
+        secp256k1_fe square, root, check;
+        secp256k1_fe_sqr(&square, &a);
+        ASSERT_TRUE(secp256k1_fe_sqrt(&root, &square)) << hex(x.begin(), x.end());
+        secp256k1_fe_sqr(&check, &root);
+        ASSERT_EQ(toHex(check), toHex(square));
+
+        // -1 is not a square for p = 3 mod 4, so exactly one of a and -a is
+        secp256k1_fe negated;
+        secp256k1_fe_negate(&negated, &a);
+        const auto isSquare = secp256k1_fe_sqrt(&root, &a);
+        if (!bn_is_zero(&ra)) {
+            ASSERT_NE(isSquare, secp256k1_fe_sqrt(&check, &negated)) << hex(x.begin(), x.end());
+        }
+        if (!isSquare) {
+            continue;
+        }
+        squares += 1;
+
+        // bn_sqrt takes the same root
+        auto expected = ra;
+        bn_sqrt(&expected, &secp256k1.prime);
+        ASSERT_EQ(toHex(root), toHex(expected)) << hex(x.begin(), x.end());
+        bn_multiply(&expected, &expected, &secp256k1.prime);
+        ASSERT_EQ(toHex(expected), toHex(ra));
+    }
+    ASSERT_GT(squares, 0u);
+}
+
+TEST(BinanceField, X4MatchesScalar) {
+    const auto all = values();
+    // every lane round trips, including the unreduced values
+    for (const auto& x : all) {
+        secp256k1_fe_x4 v;
+        secp256k1_fe r;
+        const auto a = element(x);
+        secp256k1_fe_x4_set_lane(&v, 2, &a);
+        secp256k1_fe_x4_get_lane(&r, &v, 2);
+        ASSERT_EQ(toHex(r), toHex(a));
+    }
+    if (!secp256k1_fe_x4_supported()) {
+        return;
+    }
+
+    // lane l of step i takes a = all[i + l] and b = all[i + 7 l + 1]
+    for (std::size_t i = 0; i < all.size(); i += 1) {
+        secp256k1_fe a[4], b[4];
+        secp256k1_fe_x4 va, vb, r;
+        for (auto lane = 0; lane < 4; lane += 1) {
+            a[lane] = element(all[(i + lane) % all.size()]);
+            b[lane] = element(all[(i + 7 * lane + 1) % all.size()]);
+            secp256k1_fe_x4_set_lane(&va, lane, &a[lane]);
+            secp256k1_fe_x4_set_lane(&vb, lane, &b[lane]);
+        }
+
+        secp256k1_fe expected, result;
+        secp256k1_fe_x4_mul(&r, &va, &vb);
+        for (auto lane = 0; lane < 4; lane += 1) {
+            secp256k1_fe_mul(&expected, &a[lane], &b[lane]);
+            secp256k1_fe_x4_get_lane(&result, &r, lane);
+            ASSERT_EQ(toHex(result), toHex(expected)) << "mul " << i << " lane " << lane;
+        }
+        secp256k1_fe_x4_sqr(&r, &va);
+        for (auto lane = 0; lane < 4; lane += 1) {
+            secp256k1_fe_sqr(&expected, &a[lane]);
+            secp256k1_fe_x4_get_lane(&result, &r, lane);
+            ASSERT_EQ(toHex(result), toHex(expected)) << "sqr " << i << " lane " << lane;
+        }
+        secp256k1_fe_x4_add(&r, &va, &vb);
+        for (auto lane = 0; lane < 4; lane += 1) {
+            secp256k1_fe_add(&expected, &a[lane], &b[lane]);
+            secp256k1_fe_x4_get_lane(&result, &r, lane);
+            ASSERT_EQ(toHex(result), toHex(expected)) << "add " << i << " lane " << lane;
+        }
+        secp256k1_fe_x4_sub(&r, &va, &vb);
+        for (auto lane = 0; lane < 4; lane += 1) {
+            secp256k1_fe_sub(&expected, &a[lane], &b[lane]);
+            secp256k1_fe_x4_get_lane(&result, &r, lane);
+            ASSERT_EQ(toHex(result), toHex(expected)) << "sub " << i << " lane " << lane;
+        }
+
+        // results feed further operations without a round trip
+        const uint32_t cond[4] = {0xffffffff, 0, 0xffffffff, 0};
+        secp256k1_fe_x4_cneg(&r, cond);
+        secp256k1_fe_x4_mul(&r, &r, &r);
+        for (auto lane = 0; lane < 4; lane += 1) {
+            secp256k1_fe_sub(&expected, &a[lane], &b[lane]);
+            secp256k1_fe_cneg(&expected, cond[lane]);
+            secp256k1_fe_mul(&expected, &expected, &expected);
+            secp256k1_fe_x4_get_lane(&result, &r, lane);
+            ASSERT_EQ(toHex(result), toHex(expected)) << "cneg " << i << " lane " << lane;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,103 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+
+#include "crypto/bignum.h"
+#include "crypto/secp256k1.h"
+#include "crypto/secp256k1_field.h"
+#include "crypto/secp256k1_scalar.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+
+namespace Binance {
+
+// The Fermat inversion x^(prime-2) that bn_inverse used before safegcd.
+static void fermatInverse(bignum256* x, const bignum256* prime) {
+    bignum256 res;
+    bn_one(&res);
+    for (auto i = 0; i < 9; i += 1) {
+        auto limb = prime->val[i];
+        if (i == 0) {
+            limb -= 2;
+        }
+        for (auto j = 0; j < 30; j += 1) {
+            if (i == 8 && limb == 0) {
+                break;
+            }
+            if (limb & 1) {
+                bn_multiply(x, &res, prime);
+            }
+            limb >>= 1;
+            bn_multiply(x, x, prime);
+        }
+    }
+    bn_mod(&res, prime);
+    *x = res;
+}
+
+static std::string toHex(const bignum256& x) {
+    std::array<uint8_t, 32> bytes;
+    bn_write_be(&x, bytes.data());
+    return hex(bytes.begin(), bytes.end());
+}
+
+TEST(BinanceModInverse, MatchesFermat) {
+    std::mt19937 random(29);
+    for (const auto* prime : {&secp256k1.prime, &secp256k1.order}) {
+        for (auto round = 0; round < 300; round += 1) {
+            std::array<uint8_t, 32> bytes;
+            for (auto& byte : bytes) {
+                byte = static_cast<uint8_t>(random());
+            }
+            // Sparse values and values right below the modulus
+            if (round % 3 == 1) {
+                bytes.fill(0);
+                bytes[random() % 32] = static_cast<uint8_t>(random());
+            } else if (round % 3 == 2) {
+                bn_write_be(prime, bytes.data());
+                bytes[31] -= static_cast<uint8_t>(1 + random() % 64);
+            }
+            bignum256 x;
+            bn_read_be(bytes.data(), &x);
+            bn_mod(&x, prime);
+
+            auto expected = x;
+            fermatInverse(&expected, prime);
+            auto actual = x;
+            bn_inverse(&actual, prime);
+            ASSERT_EQ(toHex(actual), toHex(expected)) << hex(bytes.begin(), bytes.end());
+
+            if (prime == &secp256k1.prime) {
+                secp256k1_fe element, inverse;
+                secp256k1_fe_set_bn(&element, &x);
+                secp256k1_fe_inv(&inverse, &element);
+                bignum256 result;
+                secp256k1_fe_get_bn(&result, &inverse);
+                ASSERT_EQ(toHex(result), toHex(expected));
+            } else {
+                secp256k1_scalar scalar;
+                secp256k1_scalar_set_bn(&scalar, &x);
+                secp256k1_scalar_inverse(&scalar, &scalar);
+                bignum256 result;
+                secp256k1_scalar_get_bn(&result, &scalar);
+                ASSERT_EQ(toHex(result), toHex(expected));
+            }
+        }
+
+        bignum256 zero;
+        bn_zero(&zero);
+        bn_inverse(&zero, prime);
+        ASSERT_TRUE(bn_is_zero(&zero));
+    }
+}
+
+} // namespace
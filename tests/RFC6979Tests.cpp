@@ -0,0 +1,121 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/hmac.h"
+#include "crypto/rfc6979.h"
+#include "crypto/secp256k1.h"
+#include "crypto/sha2.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace Binance {
+
+using Bytes = std::array<uint8_t, 32>;
+
+// The nonce derivation with one full HMAC per step, as before the prepared pad digests.
+struct ReferenceRFC6979 {
+    Bytes v, k;
+
+    ReferenceRFC6979(const Bytes& privateKey, const Bytes& hash) {
+        uint8_t buf[32 + 1 + 64];
+        v.fill(1);
+        k.fill(0);
+        for (uint8_t tag = 0; tag < 2; tag += 1) {
+            std::memcpy(buf, v.data(), 32);
+            buf[32] = tag;
+            std::memcpy(buf + 33, privateKey.data(), 32);
+            std::memcpy(buf + 65, hash.data(), 32);
+            hmac_sha256(k.data(), 32, buf, sizeof(buf), k.data());
+            hmac_sha256(k.data(), 32, v.data(), 32, v.data());
+        }
+    }
+
+    Bytes generate() {
+        uint8_t buf[33];
+        hmac_sha256(k.data(), 32, v.data(), 32, v.data());
+        std::memcpy(buf, v.data(), 32);
+        buf[32] = 0;
+        hmac_sha256(k.data(), 32, buf, sizeof(buf), k.data());
+        hmac_sha256(k.data(), 32, v.data(), 32, v.data());
+        Bytes result;
+        std::memcpy(result.data(), buf, 32);
+        return result;
+    }
+};
+
+static Bytes randomBytes(std::mt19937& random) {
+    Bytes bytes;
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(random());
+    }
+    return bytes;
+}
+
+TEST(BinanceRFC6979, MatchesReference) {
+    std::mt19937 random(41);
+    for (auto round = 0; round < 50; round += 1) {
+        const auto privateKey = randomBytes(random);
+        const auto hash = randomBytes(random);
+        auto reference = ReferenceRFC6979(privateKey, hash);
+
+        rfc6979_state state;
+        init_rfc6979(privateKey.data(), hash.data(), &state);
+        rfc6979_key key;
+        init_rfc6979_key(privateKey.data(), &key);
+        rfc6979_state keyed;
+        init_rfc6979_with_key(&key, hash.data(), &keyed);
+
+        for (auto i = 0; i < 3; i += 1) {
+            const auto expected = reference.generate();
+            Bytes nonce, keyedNonce;
+            generate_rfc6979(nonce.data(), &state);
+            generate_rfc6979(keyedNonce.data(), &keyed);
+            ASSERT_EQ(hex(nonce), hex(expected));
+            ASSERT_EQ(hex(keyedNonce), hex(expected));
+        }
+    }
+}
+
+// Private key 1 with the SHA-256 of "Satoshi Nakamoto", a widely published secp256k1 vector
+TEST(BinanceRFC6979, KnownNonce) {
+    Bytes privateKey{};
+    privateKey[31] = 1;
+    const std::string message = "Satoshi Nakamoto";
+    Bytes hash;
+    sha256_Raw(reinterpret_cast<const uint8_t*>(message.data()), message.size(), hash.data());
+
+    rfc6979_state state;
+    init_rfc6979(privateKey.data(), hash.data(), &state);
+    Bytes nonce;
+    generate_rfc6979(nonce.data(), &state);
+    ASSERT_EQ(hex(nonce), "8f8a276c19f4149656b280621e358cce24f5f52542772691ee69063b74f15d15");
+}
+
+TEST(BinanceRFC6979, SignWithKey) {
+    std::mt19937 random(43);
+    const auto privateKey = randomBytes(random);
+    rfc6979_key key;
+    init_rfc6979_key(privateKey.data(), &key);
+    for (auto round = 0; round < 10; round += 1) {
+        const auto digest = randomBytes(random);
+        uint8_t expected[64], signature[64], expectedBy, by;
+        ASSERT_EQ(ecdsa_sign_digest(&secp256k1, privateKey.data(), digest.data(), expected, &expectedBy, nullptr), 0);
+        ASSERT_EQ(ecdsa_sign_digest_key(&secp256k1, &key, digest.data(), signature, &by, nullptr), 0);
+        ASSERT_EQ(hex(signature, signature + 64), hex(expected, expected + 64));
+        ASSERT_EQ(by, expectedBy);
+    }
+}
+
+} // namespace
@@ -0,0 +1,77 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+
+#include "crypto/ripemd160.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace Binance {
+
+TEST(BinanceRIPEMD160, MultiLaneMatchesScalar) {
+    std::mt19937 random(17);
+    ASSERT_NE(ripemd160_get_lanes(), 0);
+
+    for (auto lanes : {1, 4, 8}) {
+        if (!ripemd160_set_lanes(lanes)) {
+            continue;
+        }
+        ASSERT_EQ(ripemd160_get_lanes(), lanes);
+
+        for (auto count = 0; count < 21; count += 1) {
+            std::vector<std::array<uint8_t, 32>> messages(count);
+            std::vector<std::array<uint8_t, RIPEMD160_DIGEST_LENGTH>> hashes(count);
+            std::vector<uint8_t*> inputs;
+            std::vector<uint8_t*> outputs;
+            for (auto i = 0; i < count; i += 1) {
+                for (auto& byte : messages[i]) {
+                    byte = static_cast<uint8_t>(random());
+                }
+                inputs.push_back(messages[i].data());
+                outputs.push_back(hashes[i].data());
+            }
+
+            ripemd160_32_xN(inputs.data(), count, outputs.data());
+            for (auto i = 0; i < count; i += 1) {
+                uint8_t expected[RIPEMD160_DIGEST_LENGTH];
+                ripemd160(messages[i].data(), 32, expected);
+                ASSERT_EQ(hex(hashes[i].begin(), hashes[i].end()), hex(expected, expected + sizeof(expected))) << lanes << " lanes";
+            }
+
+            // Hashing in place, as HASHER_SHA2_RIPEMD does
+            ripemd160_32_xN(inputs.data(), count, inputs.data());
+            for (auto i = 0; i < count; i += 1) {
+                ASSERT_EQ(hex(messages[i].begin(), messages[i].begin() + RIPEMD160_DIGEST_LENGTH), hex(hashes[i].begin(), hashes[i].end())) << lanes << " lanes";
+            }
+        }
+    }
+    ripemd160_set_lanes(0);
+    ASSERT_FALSE(ripemd160_set_lanes(2));
+}
+
+TEST(BinanceRIPEMD160, KnownDigest) {
+    // Eight lanes of 32 zero bytes
+    std::array<uint8_t, 32> message{};
+    std::vector<std::array<uint8_t, RIPEMD160_DIGEST_LENGTH>> hashes(8);
+    std::vector<const uint8_t*> inputs(8, message.data());
+    std::vector<uint8_t*> outputs;
+    for (auto& hash : hashes) {
+        outputs.push_back(hash.data());
+    }
+
+    ripemd160_32_xN(inputs.data(), inputs.size(), outputs.data());
+    for (const auto& hash : hashes) {
+        ASSERT_EQ(hex(hash.begin(), hash.end()), "d1a70126ff7a149ca6f9b638db084480440ff842");
+    }
+}
+
+} // namespace
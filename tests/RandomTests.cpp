@@ -0,0 +1,93 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "crypto/rand.h"
+
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Binance {
+
+using Block = std::array<uint8_t, 32>;
+
+static Block randomBlock() {
+    Block block;
+    random_buffer(block.data(), block.size());
+    return block;
+}
+
+TEST(BinanceRandom, Distinct) {
+    std::set<Block> blocks;
+    for (auto i = 0; i < 1000; i += 1) {
+        ASSERT_TRUE(blocks.insert(randomBlock()).second);
+    }
+
+    std::set<uint32_t> values;
+    for (auto i = 0; i < 1000; i += 1) {
+        values.insert(random32());
+    }
+    ASSERT_GT(values.size(), 990u);
+}
+
+TEST(BinanceRandom, LargeBuffer) {
+    // Spans several refills of the generator's buffer
+    std::vector<uint8_t> buffer(100000);
+    random_buffer(buffer.data(), buffer.size());
+
+    std::array<std::size_t, 256> counts{};
+    for (auto byte : buffer) {
+        counts[byte] += 1;
+    }
+    for (auto count : counts) {
+        ASSERT_GT(count, 250u);
+        ASSERT_LT(count, 550u);
+    }
+}
+
+TEST(BinanceRandom, Threads) {
+    std::array<Block, 4> blocks;
+    std::vector<std::thread> threads;
+    for (auto& block : blocks) {
+        threads.emplace_back([&block] { block = randomBlock(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(std::set<Block>(blocks.begin(), blocks.end()).size(), blocks.size());
+}
+
+TEST(BinanceRandom, Fork) {
+    // Leaves output buffered in the parent, which the child must not repeat
+    randomBlock();
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        const auto block = randomBlock();
+        const auto written = write(fds[1], block.data(), block.size());
+        _exit(written == static_cast<ssize_t>(block.size()) ? 0 : 1);
+    }
+    close(fds[1]);
+    const auto parent = randomBlock();
+    Block child;
+    ASSERT_EQ(read(fds[0], child.data(), child.size()), static_cast<ssize_t>(child.size()));
+    close(fds[0]);
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_NE(parent, child);
+}
+
+} // namespace
@@ -0,0 +1,180 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+
+#include "crypto/hasher.h"
+#include "crypto/hmac.h"
+#include "crypto/sha2.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Binance {
+
+static const sha256_backend backends[] = {SHA256_BACKEND_PORTABLE, SHA256_BACKEND_AVX2, SHA256_BACKEND_SHANI};
+
+// Restores automatic backend selection when a test ends.
+struct BackendGuard {
+    ~BackendGuard() {
+        sha256_set_backend(SHA256_BACKEND_AUTO);
+        sha256_set_lanes(0);
+    }
+};
+
+// Random messages whose lengths cover zero, one and several blocks.
+static std::vector<std::vector<uint8_t>> randomMessages(std::mt19937& random, std::size_t count) {
+    std::vector<std::vector<uint8_t>> messages(count);
+    for (auto& message : messages) {
+        message.resize(random() % 200);
+        for (auto& byte : message) {
+            byte = static_cast<uint8_t>(random());
+        }
+    }
+    return messages;
+}
+
+static std::string digest(const std::vector<uint8_t>& data) {
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    sha256_Raw(data.data(), data.size(), hash);
+    return hex(hash, hash + sizeof(hash));
+}
+
+TEST(BinanceSHA256, Backends) {
+    BackendGuard guard;
+    ASSERT_TRUE(sha256_backend_supported(SHA256_BACKEND_PORTABLE));
+    ASSERT_NE(sha256_get_backend(), SHA256_BACKEND_AUTO);
+
+    for (auto backend : backends) {
+        if (!sha256_backend_supported(backend)) {
+            ASSERT_FALSE(sha256_set_backend(backend));
+            continue;
+        }
+        ASSERT_TRUE(sha256_set_backend(backend));
+        ASSERT_EQ(sha256_get_backend(), backend);
+
+        ASSERT_EQ(digest({}), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        const std::string abc = "abc";
+        ASSERT_EQ(digest({abc.begin(), abc.end()}), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        const std::string twoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+        ASSERT_EQ(digest({twoBlocks.begin(), twoBlocks.end()}), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    }
+}
+
+TEST(BinanceSHA256, BackendsMatchPortable) {
+    BackendGuard guard;
+    std::mt19937 random(7);
+
+    for (auto length = 0; length < 300; length += 1) {
+        std::vector<uint8_t> data(length);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(random());
+        }
+        uint32_t state[8], block[16];
+        for (auto& word : state) {
+            word = random();
+        }
+        for (auto& word : block) {
+            word = random();
+        }
+
+        sha256_set_backend(SHA256_BACKEND_PORTABLE);
+        const auto expected = digest(data);
+        uint32_t expectedState[8];
+        sha256_Transform(state, block, expectedState);
+        uint8_t expectedMac[SHA256_DIGEST_LENGTH];
+        hmac_sha256(data.data(), data.size(), data.data(), data.size(), expectedMac);
+
+        for (auto backend : backends) {
+            if (!sha256_set_backend(backend)) {
+                continue;
+            }
+            ASSERT_EQ(digest(data), expected) << "backend " << backend << ", length " << length;
+
+            uint32_t transformed[8];
+            sha256_Transform(state, block, transformed);
+            ASSERT_TRUE(std::equal(transformed, transformed + 8, expectedState)) << "backend " << backend;
+
+            uint32_t inPlace[8];
+            std::copy(state, state + 8, inPlace);
+            sha256_Transform(inPlace, block, inPlace);
+            ASSERT_TRUE(std::equal(inPlace, inPlace + 8, expectedState)) << "backend " << backend;
+
+            uint8_t mac[SHA256_DIGEST_LENGTH];
+            hmac_sha256(data.data(), data.size(), data.data(), data.size(), mac);
+            ASSERT_TRUE(std::equal(mac, mac + sizeof(mac), expectedMac)) << "backend " << backend;
+        }
+    }
+}
+
+TEST(BinanceSHA256, MultiBuffer) {
+    BackendGuard guard;
+    std::mt19937 random(11);
+    ASSERT_NE(sha256_get_lanes(), 0);
+
+    for (auto lanes : {1, 4, 8}) {
+        if (!sha256_set_lanes(lanes)) {
+            continue;
+        }
+        ASSERT_EQ(sha256_get_lanes(), lanes);
+
+        for (auto count = 0; count < 20; count += 1) {
+            const auto messages = randomMessages(random, count);
+            std::vector<const uint8_t*> data;
+            std::vector<size_t> lengths;
+            for (const auto& message : messages) {
+                data.push_back(message.data());
+                lengths.push_back(message.size());
+            }
+            std::vector<std::array<uint8_t, SHA256_DIGEST_LENGTH>> digests(count);
+            std::vector<uint8_t*> outputs;
+            for (auto& d : digests) {
+                outputs.push_back(d.data());
+            }
+
+            sha256_Raw_xN(data.data(), lengths.data(), count, outputs.data());
+            for (auto i = 0; i < count; i += 1) {
+                ASSERT_EQ(hex(digests[i].begin(), digests[i].end()), digest(messages[i])) << lanes << " lanes, length " << lengths[i];
+            }
+        }
+    }
+    ASSERT_FALSE(sha256_set_lanes(3));
+}
+
+TEST(BinanceSHA256, HasherMultiBuffer) {
+    BackendGuard guard;
+    std::mt19937 random(13);
+    const auto messages = randomMessages(random, 19);
+
+    for (auto type : {HASHER_SHA2, HASHER_SHA2D, HASHER_SHA2_RIPEMD}) {
+        std::vector<const uint8_t*> data;
+        std::vector<size_t> lengths;
+        for (const auto& message : messages) {
+            data.push_back(message.data());
+            lengths.push_back(message.size());
+        }
+        std::vector<std::array<uint8_t, HASHER_DIGEST_LENGTH>> hashes(messages.size());
+        std::vector<uint8_t*> outputs;
+        for (auto& hash : hashes) {
+            outputs.push_back(hash.data());
+        }
+
+        hasher_Raw_xN(type, data.data(), lengths.data(), messages.size(), outputs.data());
+        for (size_t i = 0; i < messages.size(); i += 1) {
+            uint8_t expected[HASHER_DIGEST_LENGTH];
+            hasher_Raw(type, messages[i].data(), messages[i].size(), expected);
+            const auto length = type == HASHER_SHA2_RIPEMD ? 20 : HASHER_DIGEST_LENGTH;
+            ASSERT_EQ(hex(hashes[i].begin(), hashes[i].begin() + length), hex(expected, expected + length)) << "type " << type;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,147 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+
+#include "crypto/bignum.h"
+#include "crypto/secp256k1.h"
+#include "crypto/secp256k1_scalar.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Binance {
+
+using Bytes = std::array<uint8_t, 32>;
+
+static std::string toHex(const secp256k1_scalar& a) {
+    Bytes bytes;
+    secp256k1_scalar_get_b32(bytes.data(), &a);
+    return hex(bytes.begin(), bytes.end());
+}
+
+static std::string toHex(bignum256 x) {
+    bn_fast_mod(&x, &secp256k1.order);
+    bn_mod(&x, &secp256k1.order);
+    Bytes bytes;
+    bn_write_be(&x, bytes.data());
+    return hex(bytes.begin(), bytes.end());
+}
+
+// Random scalars plus the ones next to 0, n/2, n and 2^256.
+static std::vector<Bytes> values() {
+    std::vector<Bytes> result;
+    for (const auto* edge : {&secp256k1.order, &secp256k1.order_half}) {
+        Bytes bytes;
+        bn_write_be(edge, bytes.data());
+        for (int delta = -2; delta <= 2; delta += 1) {
+            auto value = bytes;
+            value[31] += delta;
+            result.push_back(value);
+        }
+    }
+    Bytes ones;
+    ones.fill(0xff);
+    result.push_back(ones);
+    result.push_back(Bytes{});
+    Bytes one{};
+    one[31] = 1;
+    result.push_back(one);
+
+    std::mt19937 random(23);
+    while (result.size() < 50) {
+        Bytes value;
+        for (auto& byte : value) {
+            byte = static_cast<uint8_t>(random());
+        }
+        result.push_back(value);
+    }
+    return result;
+}
+
+TEST(BinanceScalar, MatchesBignum) {
+    const auto all = values();
+    for (const auto& x : all) {
+        secp256k1_scalar a;
+        bignum256 ra;
+        bn_read_be(x.data(), &ra);
+        const auto overflow = secp256k1_scalar_set_b32(&a, x.data());
+        ASSERT_EQ(overflow, !bn_is_less(&ra, &secp256k1.order));
+        bn_mod(&ra, &secp256k1.order);
+        ASSERT_EQ(toHex(a), toHex(ra));
+
+        bignum256 converted;
+        secp256k1_scalar_get_bn(&converted, &a);
+        ASSERT_TRUE(bn_is_equal(&converted, &ra));
+
+        ASSERT_EQ(secp256k1_scalar_is_high(&a), bn_is_less(&secp256k1.order_half, &ra));
+
+        secp256k1_scalar r;
+        secp256k1_scalar_negate(&r, &a);
+        secp256k1_scalar_add(&r, &r, &a);
+        ASSERT_TRUE(secp256k1_scalar_is_zero(&r));
+
+        secp256k1_scalar_inverse(&r, &a);
+        if (bn_is_zero(&ra)) {
+            ASSERT_TRUE(secp256k1_scalar_is_zero(&r));
+        } else {
+            auto expected = ra;
+            bn_inverse(&expected, &secp256k1.order);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "inverse " << hex(x.begin(), x.end());
+        }
+
+        for (const auto& y : all) {
+            secp256k1_scalar b;
+            bignum256 rb;
+            secp256k1_scalar_set_b32(&b, y.data());
+            bn_read_be(y.data(), &rb);
+            bn_mod(&rb, &secp256k1.order);
+
+            secp256k1_scalar_mul(&r, &a, &b);
+            auto expected = rb;
+            bn_multiply(&ra, &expected, &secp256k1.order);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "mul " << hex(x.begin(), x.end()) << " " << hex(y.begin(), y.end());
+
+            secp256k1_scalar_mul_add(&r, &a, &b, &a);
+            bn_addmod(&expected, &ra, &secp256k1.order);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "mul_add " << hex(x.begin(), x.end()) << " " << hex(y.begin(), y.end());
+
+            secp256k1_scalar_add(&r, &a, &b);
+            expected = ra;
+            bn_addmod(&expected, &rb, &secp256k1.order);
+            ASSERT_EQ(toHex(r), toHex(expected)) << "add " << hex(x.begin(), x.end()) << " " << hex(y.begin(), y.end());
+        }
+    }
+}
+
+TEST(BinanceScalar, InverseBatch) {
+    std::vector<secp256k1_scalar> batch;
+    std::vector<std::string> expected;
+    for (const auto& x : values()) {
+        secp256k1_scalar a;
+        secp256k1_scalar_set_b32(&a, x.data());
+        if (secp256k1_scalar_is_zero(&a)) {
+            continue;
+        }
+        secp256k1_scalar r;
+        secp256k1_scalar_inverse(&r, &a);
+        batch.push_back(a);
+        expected.push_back(toHex(r));
+    }
+
+    std::vector<secp256k1_scalar> scratch(batch.size());
+    secp256k1_scalar_inverse_batch(batch.data(), scratch.data(), batch.size());
+    for (std::size_t i = 0; i < batch.size(); i += 1) {
+        ASSERT_EQ(toHex(batch[i]), expected[i]);
+    }
+}
+
+} // namespace
@@ -0,0 +1,124 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+#include "Serialization.h"
+#include "SerializationJSON.h"
+#include "Signer.h"
+
+#include "dex.pb.h"
+
+#include <gtest/gtest.h>
+
+namespace Binance {
+
+// Builds the preimage through the nlohmann DOM, as `signaturePreimage` used to.
+static std::string referencePreimage(const Signer& signer) {
+    nlohmann::json j;
+    j["account_number"] = std::to_string(signer.accountNumber);
+    j["chain_id"] = signer.chainId;
+    j["data"] = nullptr;
+    j["memo"] = signer.memo;
+    j["msgs"] = nlohmann::json::array({ orderJSON(signer.order) });
+    j["sequence"] = std::to_string(signer.sequence);
+    j["source"] = std::to_string(signer.source);
+    return j.dump();
+}
+
+static void expectPreimage(const ::google::protobuf::Message& order) {
+    auto signer = Signer(order);
+    signer.chainId = "Binance-Chain-Tigris";
+    signer.accountNumber = 12;
+    signer.sequence = -35;
+    signer.source = 1;
+    signer.memo = "quote \" slash \\ tab \t newline \n bell \x07 del \x7f utf8 \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";
+
+    std::string reused = "stale contents";
+    writeSignaturePreimage(signer, reused);
+    EXPECT_EQ(reused, referencePreimage(signer));
+    EXPECT_EQ(signaturePreimage(signer), reused);
+
+    byte expected[SHA256_DIGEST_LENGTH];
+    sha256_Raw(reinterpret_cast<const byte*>(reused.data()), reused.size(), expected);
+    auto sink = SHA256Sink();
+    writeSignaturePreimage(signer, sink);
+    byte hash[SHA256_DIGEST_LENGTH];
+    sink.finish(hash);
+    EXPECT_EQ(hex(hash, hash + sizeof(hash)), hex(expected, expected + sizeof(expected)));
+}
+
+static const auto keyhash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+
+TEST(BinanceSerialization, NewOrderPreimage) {
+    auto order = NewOrder();
+    order.set_sender(keyhash.data(), keyhash.size());
+    order.set_id("BA36F0FAD74D8F41045463E4774F328F4AF779E5-36");
+    order.set_symbol("NNB-338_BNB");
+    order.set_ordertype(2);
+    order.set_side(1);
+    order.set_price(136350000);
+    order.set_quantity(INT64_MIN);
+    order.set_timeinforce(INT64_MAX);
+    expectPreimage(order);
+}
+
+TEST(BinanceSerialization, CancelOrderPreimage) {
+    auto order = CancelOrder();
+    order.set_sender("printable sender");
+    order.set_symbol("NNB-338_BNB");
+    order.set_refid("BA36F0FAD74D8F41045463E4774F328F4AF779E5-29");
+    expectPreimage(order);
+}
+
+TEST(BinanceSerialization, SendPreimage) {
+    auto order = Send();
+    expectPreimage(order);
+
+    for (auto i = 0; i < 3; i += 1) {
+        auto input = order.add_inputs();
+        input->set_address(keyhash.data(), keyhash.size());
+        for (auto j = 0; j < i; j += 1) {
+            auto coin = input->add_coins();
+            coin->set_denom("BNB");
+            coin->set_amount(1'001'000'000 * j);
+        }
+        auto output = order.add_outputs();
+        output->set_address(keyhash.data(), keyhash.size());
+        auto coin = output->add_coins();
+        coin->set_denom("NNB-338");
+        coin->set_amount(-i);
+    }
+    expectPreimage(order);
+}
+
+TEST(BinanceSerialization, FreezePreimage) {
+    auto freeze = TokenFreeze();
+    freeze.set_from(keyhash.data(), keyhash.size());
+    freeze.set_symbol("NNB-338");
+    freeze.set_amount(100000000);
+    expectPreimage(freeze);
+
+    auto unfreeze = TokenUnfreeze();
+    unfreeze.set_from(keyhash.data(), keyhash.size());
+    unfreeze.set_symbol("NNB-338");
+    unfreeze.set_amount(0);
+    expectPreimage(unfreeze);
+}
+
+TEST(BinanceSerialization, InvalidPreimage) {
+    auto order = CancelOrder();
+    order.set_symbol("NNB-338_BNB");
+    auto signer = Signer(order);
+    signer.memo = "truncated \xe2\x82";
+    ASSERT_THROW(signaturePreimage(signer), std::invalid_argument);
+
+    auto transaction = Transaction();
+    auto other = Signer(transaction);
+    ASSERT_THROW(signaturePreimage(other), std::invalid_argument);
+}
+
+} // namespace
@@ -7,6 +7,7 @@
 
 #include "Address.h"
 #include "HexCoding.h"
+#include "Serialization.h"
 #include "Signer.h"
 
 #include "dex.pb.h"
@@ -44,6 +45,36 @@ TEST(BinanceSigner, Sign) {
     ASSERT_EQ(hex(signature.begin(), signature.end()), "9123cb6906bb20aeb753f4a121d4d88ff0e9750ba75b0c4e10d76caee1e7d2481290fa3b9887a6225d6997f5f939ef834ea61d596a314237c48e560da9e17b5a");
 }
 
+TEST(BinanceSigner, SignWithPreimage) {
+    auto order = NewOrder();
+    order.set_id("BA36F0FAD74D8F41045463E4774F328F4AF779E5-36");
+    order.set_symbol("NNB-338_BNB");
+    order.set_ordertype(2);
+    order.set_side(1);
+    order.set_price(136350000);
+    order.set_quantity(100000000);
+    order.set_timeinforce(1);
+
+    auto signer = Signer(order);
+    signer.accountNumber = 12;
+    signer.sequence = 35;
+    signer.privateKey = parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9");
+
+    const auto signature = signer.sign();
+
+    std::string preimage = "stale contents";
+    ASSERT_EQ(signer.sign(preimage), signature);
+    ASSERT_EQ(preimage, signaturePreimage(signer));
+
+    auto typed = TypedSigner<NewOrder>(order);
+    typed.accountNumber = signer.accountNumber;
+    typed.sequence = signer.sequence;
+    typed.privateKey = signer.privateKey;
+    std::string typedPreimage;
+    ASSERT_EQ(typed.sign(typedPreimage), signature);
+    ASSERT_EQ(typedPreimage, preimage);
+}
+
 TEST(BinanceSigner, Build) {
     auto order = NewOrder();
     auto address = Address(Address::binanceHRP, parse_hex("b6561dcc104130059a7c08f48c64610c1f6f9064"));
@@ -136,4 +167,83 @@ TEST(BinanceSigner, BuildSend) {
     );
 }
 
+TEST(BinanceSigner, BuildBatch) {
+    const auto keyhash = parse_hex("b6561dcc104130059a7c08f48c64610c1f6f9064");
+    const auto privateKeys = std::vector<Data>{
+        parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9"),
+        parse_hex("95949f757db1f57ca94a5dff23314accbe7abee89597bf6a3c7382c84d7eb832"),
+    };
+
+    std::vector<NewOrder> orders(40);
+    std::vector<Signer> signers;
+    for (std::size_t i = 0; i < orders.size(); i += 1) {
+        auto& order = orders[i];
+        order.set_sender(keyhash.data(), keyhash.size());
+        order.set_id("B6561DCC104130059A7C08F48C64610C1F6F9064-" + std::to_string(i));
+        order.set_symbol("BTC-5C4_BNB");
+        order.set_ordertype(2);
+        order.set_side(1 + i % 2);
+        order.set_price(100000000 + i);
+        order.set_quantity(1200000000);
+        order.set_timeinforce(1);
+
+        auto signer = Signer(order);
+        signer.accountNumber = 1 + i % 2;
+        signer.sequence = i;
+        signer.privateKey = privateKeys[i % 2];
+        signers.push_back(signer);
+    }
+    signers[3].privateKey = Data(32, 0);
+    signers[5].signingKey = std::make_shared<const SigningKey>(privateKeys[0]);
+
+    const auto transactions = Signer::buildBatch(signers, 4);
+    const auto signatures = Signer::signBatch(signers, 3);
+    ASSERT_EQ(transactions.size(), signers.size());
+    ASSERT_EQ(signatures.size(), signers.size());
+    for (std::size_t i = 0; i < signers.size(); i += 1) {
+        EXPECT_EQ(hex(transactions[i]), hex(signers[i].build()));
+        EXPECT_EQ(hex(signatures[i]), hex(signers[i].sign()));
+    }
+    EXPECT_TRUE(transactions[3].empty());
+    EXPECT_FALSE(transactions[5].empty());
+    EXPECT_TRUE(Signer::buildBatch({}, 4).empty());
+}
+
+TEST(BinanceSigner, TypedSigner) {
+    auto order = Send();
+    auto fromKeyhash = parse_hex("40c2979694bbc961023d1d27be6fc4d21a9febe6");
+    auto input = order.add_inputs();
+    input->set_address(fromKeyhash.data(), fromKeyhash.size());
+    auto inputCoin = input->add_coins();
+    inputCoin->set_denom("BNB");
+    inputCoin->set_amount(1'001'000'000);
+    auto toKeyhash = parse_hex("88b37d5e05f3699e2a1406468e5d87cb9dcceb95");
+    auto output = order.add_outputs();
+    output->set_address(toKeyhash.data(), toKeyhash.size());
+    auto outputCoin = output->add_coins();
+    outputCoin->set_denom("BNB");
+    outputCoin->set_amount(1'001'000'000);
+
+    auto signer = TypedSigner<Send>(order);
+    signer.chainId = "chain-bnb";
+    signer.accountNumber = 19;
+    signer.sequence = 23;
+    signer.memo = "test";
+    signer.source = 1;
+    signer.privateKey = parse_hex("95949f757db1f57ca94a5dff23314accbe7abee89597bf6a3c7382c84d7eb832");
+
+    auto dynamic = Signer(order);
+    static_cast<SignerBase&>(dynamic) = signer;
+
+    ASSERT_EQ(hex(signer.sign()), "c65a13440f18a155bd971ee40b9e0dd58586f5bf344e12ec4c76c439aebca8c7789bab7bfbfb4ce89aadc4a02df225b6b6efc861c13bbeb5f7a3eea2d7ffc80f");
+    ASSERT_EQ(hex(signer.build()), hex(dynamic.build()));
+
+    auto cancel = CancelOrder();
+    cancel.set_symbol("BTC-5C4_BNB");
+    cancel.set_refid("B6561DCC104130059A7C08F48C64610C1F6F9064-11");
+    auto cancelSigner = TypedSigner<CancelOrder>(cancel, std::make_shared<const SigningKey>(signer.privateKey));
+    auto dynamicCancel = Signer(cancel, cancelSigner.signingKey);
+    ASSERT_EQ(hex(cancelSigner.build()), hex(dynamicCancel.build()));
+}
+
 } // namespace
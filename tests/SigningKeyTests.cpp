@@ -0,0 +1,61 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+#include "Signer.h"
+#include "SigningKey.h"
+
+#include "dex.pb.h"
+
+#include <gtest/gtest.h>
+
+namespace Binance {
+
+TEST(BinanceSigningKey, Derive) {
+    auto key = SigningKey(parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9"));
+
+    ASSERT_EQ(hex(key.publicKey), "029729a52e4e3c2b4a4e52aa74033eedaf8ba1df5ab6d1f518fd69e67bbd309b0e");
+    ASSERT_EQ(hex(key.aminoPublicKey), "eb5ae98721029729a52e4e3c2b4a4e52aa74033eedaf8ba1df5ab6d1f518fd69e67bbd309b0e");
+    ASSERT_EQ(hex(key.keyHash), "ba36f0fad74d8f41045463e4774f328f4af779e5");
+    ASSERT_EQ(key.address, "bnb1hgm0p7khfk85zpz5v0j8wnej3a90w709vhkdfu");
+
+    auto testKey = SigningKey(key.privateKey, Address::binanceTestHRP);
+    ASSERT_EQ(testKey.address, "tbnb1hgm0p7khfk85zpz5v0j8wnej3a90w709zzlffd");
+}
+
+TEST(BinanceSigningKey, Invalid) {
+    ASSERT_THROW(SigningKey(Data(31, 1)), std::invalid_argument);
+    ASSERT_THROW(SigningKey(Data(32, 0)), std::invalid_argument);
+    ASSERT_THROW(SigningKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141")), std::invalid_argument);
+}
+
+TEST(BinanceSigningKey, Build) {
+    auto order = NewOrder();
+    auto keyhash = parse_hex("ba36f0fad74d8f41045463e4774f328f4af779e5");
+    order.set_sender(keyhash.data(), keyhash.size());
+    order.set_id("B6561DCC104130059A7C08F48C64610C1F6F9064-11");
+    order.set_symbol("BTC-5C4_BNB");
+    order.set_ordertype(2);
+    order.set_side(1);
+    order.set_price(100000000);
+    order.set_quantity(1200000000);
+    order.set_timeinforce(1);
+
+    auto signer = Signer(order);
+    signer.accountNumber = 1;
+    signer.sequence = 10;
+    signer.privateKey = parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9");
+
+    auto keyed = Signer(order, std::make_shared<const SigningKey>(signer.privateKey));
+    keyed.accountNumber = 1;
+    keyed.sequence = 10;
+
+    ASSERT_EQ(hex(keyed.sign()), hex(signer.sign()));
+    ASSERT_EQ(hex(keyed.build()), hex(signer.build()));
+}
+
+} // namespace
@@ -0,0 +1,143 @@
+// Copyright © 2019 All BNB Chain Developers.
+//
+// This file is part of the BNB Chain SDK. The full BNB Chain SDK
+// copyright notice, including terms governing use, modification, and
+// redistribution, is contained in the file LICENSE at the root of the source
+// code distribution tree.
+
+#include "HexCoding.h"
+#include "SigningKey.h"
+#include "VerificationCache.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/secp256k1.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Binance {
+
+struct Signed {
+    Data publicKey;
+    Data signature;
+    Data digest;
+};
+
+static Signed sign(byte seed, byte message) {
+    const auto key = SigningKey(Data(32, seed));
+    auto digest = Data(32, message);
+    auto signature = Data(64);
+    ecdsa_sign_digest(&secp256k1, key.privateKey.data(), digest.data(), signature.data(), nullptr, nullptr);
+    return {key.publicKey, signature, digest};
+}
+
+TEST(BinanceVerificationCache, Verify) {
+    VerificationCache cache;
+    auto item = sign(1, 7);
+
+    ASSERT_TRUE(cache.verify(item.publicKey, item.signature, item.digest));
+    ASSERT_TRUE(cache.verify(item.publicKey, item.signature, item.digest));
+    ASSERT_EQ(cache.misses(), 1u);
+    ASSERT_EQ(cache.hits(), 1u);
+    ASSERT_EQ(cache.size(), 1u);
+
+    auto other = sign(2, 7);
+    ASSERT_FALSE(cache.verify(item.publicKey, other.signature, item.digest));
+    item.digest[0] ^= 1;
+    ASSERT_FALSE(cache.verify(item.publicKey, item.signature, item.digest));
+}
+
+TEST(BinanceVerificationCache, Invalid) {
+    VerificationCache cache;
+    const auto item = sign(1, 7);
+
+    ASSERT_FALSE(cache.verify(Data(item.publicKey.begin(), item.publicKey.end() - 1), item.signature, item.digest));
+    ASSERT_FALSE(cache.verify(item.publicKey, Data(63), item.digest));
+    ASSERT_FALSE(cache.verify(item.publicKey, item.signature, Data(31)));
+
+    // x = 5 has no point on the curve
+    auto offCurve = parse_hex("020000000000000000000000000000000000000000000000000000000000000005");
+    ASSERT_FALSE(cache.verify(offCurve, item.signature, item.digest));
+    ASSERT_FALSE(cache.verify(offCurve, item.signature, item.digest));
+
+    // 33 bytes with other prefixes than 0x02 and 0x03, which must not be read as uncompressed keys
+    for (byte prefix : {0x04, 0x06, 0x07, 0x00}) {
+        auto key = item.publicKey;
+        key[0] = prefix;
+        ASSERT_FALSE(cache.verify(key, item.signature, item.digest));
+    }
+    ASSERT_EQ(cache.size(), 0u);
+}
+
+TEST(BinanceVerificationCache, Eviction) {
+    VerificationCache cache(2);
+    const auto a = sign(1, 7);
+    const auto b = sign(2, 7);
+    const auto c = sign(3, 7);
+
+    ASSERT_TRUE(cache.verify(a.publicKey, a.signature, a.digest));
+    ASSERT_TRUE(cache.verify(b.publicKey, b.signature, b.digest));
+    ASSERT_TRUE(cache.verify(a.publicKey, a.signature, a.digest));
+    // Evicts b, the least recently used key
+    ASSERT_TRUE(cache.verify(c.publicKey, c.signature, c.digest));
+    ASSERT_EQ(cache.size(), 2u);
+    ASSERT_EQ(cache.hits(), 1u);
+
+    ASSERT_TRUE(cache.verify(a.publicKey, a.signature, a.digest));
+    ASSERT_EQ(cache.hits(), 2u);
+    ASSERT_TRUE(cache.verify(b.publicKey, b.signature, b.digest));
+    ASSERT_EQ(cache.hits(), 2u);
+    ASSERT_EQ(cache.misses(), 4u);
+
+    VerificationCache disabled(0);
+    ASSERT_TRUE(disabled.verify(a.publicKey, a.signature, a.digest));
+    ASSERT_TRUE(disabled.verify(a.publicKey, a.signature, a.digest));
+    ASSERT_EQ(disabled.size(), 0u);
+    ASSERT_EQ(disabled.misses(), 2u);
+}
+
+TEST(BinanceVerificationCache, MatchesVerifyDigest) {
+    VerificationCache cache(4);
+    for (byte seed = 1; seed <= 8; seed += 1) {
+        for (byte message = 0; message < 4; message += 1) {
+            const auto item = sign(seed, message);
+            const auto other = sign(seed, message + 1);
+            for (const auto& signature : {item.signature, other.signature}) {
+                const auto expected = ecdsa_verify_digest(&secp256k1, item.publicKey.data(), signature.data(), item.digest.data()) == 0;
+                ASSERT_EQ(cache.verify(item.publicKey, signature, item.digest), expected);
+            }
+        }
+    }
+}
+
+TEST(BinanceVerificationCache, Threads) {
+    VerificationCache cache(3);
+    std::vector<Signed> items;
+    for (byte seed = 1; seed <= 5; seed += 1) {
+        items.push_back(sign(seed, seed));
+    }
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; t += 1) {
+        threads.emplace_back([&, t] {
+            for (auto i = 0; i < 20; i += 1) {
+                const auto& item = items[(i + t) % items.size()];
+                if (!cache.verify(item.publicKey, item.signature, item.digest)) {
+                    failures += 1;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(failures, 0);
+    ASSERT_EQ(cache.hits() + cache.misses(), 80u);
+    ASSERT_LE(cache.size(), 3u);
+}
+
+} // namespace
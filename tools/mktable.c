@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2019 All BNB Chain Developers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// Prints the fixed-base table of secp256k1 with the window width given on
+// the command line, in the form secp256k1.c includes as secp256k1_comb.table.
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ecdsa.h"
+#include "secp256k1.h"
+
+static void print_fe(const secp256k1_fe *a)
+{
+	printf("{{0x%016" PRIx64 "ULL, 0x%016" PRIx64 "ULL, 0x%016" PRIx64 "ULL, 0x%016" PRIx64 "ULL}}",
+		a->n[0], a->n[1], a->n[2], a->n[3]);
+}
+
+int main(int argc, char **argv)
+{
+	int window, i, j;
+	fe_curve_point *table;
+
+	window = argc == 2 ? atoi(argv[1]) : 0;
+	if (window < ECDSA_COMB_MIN_WINDOW || window > ECDSA_COMB_MAX_WINDOW) {
+		fprintf(stderr, "usage: %s window (%d to %d)\n", argv[0], ECDSA_COMB_MIN_WINDOW, ECDSA_COMB_MAX_WINDOW);
+		return 1;
+	}
+	table = malloc(ECDSA_COMB_SIZE(window) * sizeof(fe_curve_point));
+	if (!table) {
+		return 1;
+	}
+	ecdsa_comb_init(&secp256k1, window, table);
+
+	printf("/* generated by tools/mktable %d, do not edit */\n", window);
+	for (i = 0; i < ECDSA_COMB_DIGITS(window); i++) {
+		for (j = 0; j < 1 << (window - 1); j++) {
+			const fe_curve_point *p = &table[(i << (window - 1)) + j];
+			printf("\t/* %d*2^%d*G: */\n\t{", 2 * j + 1, window * i);
+			print_fe(&p->x);
+			printf(", ");
+			print_fe(&p->y);
+			printf("},\n");
+		}
+	}
+	free(table);
+	return 0;
+}